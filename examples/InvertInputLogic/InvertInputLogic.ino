@@ -35,6 +35,9 @@ using namespace jsc;
 constexpr static byte INPUT_PIN_BUTTON1 = A1;
 constexpr static byte INPUT_PIN_BUTTON2 = A2;
 
+/* Both buttons share a single timing profile stored in flash: debounce, click and long press time [ms] */
+const ButtonTiming BUTTON_TIMING PROGMEM = {100, DEFAULT_CLICK_TICKS_MS, 3000};
+
 class TwoButtons : private virtual IOnClickListener,
                    private virtual IOnDoubleClickListener, private virtual IOnPressListener {
 public:
@@ -140,17 +143,15 @@ void TwoButtons::init() {
     }
     Serial.println("Starting TwoButtons...");
 
-    button1.setDebounceTicks(100);
+    button1.setTimingP(&BUTTON_TIMING);
     button1.setOnClickListener(this);
     button1.setOnDoubleClickListener(this);
     button1.setOnPressListener(this);
-    button1.setLongPressTicks(3000 /* ms */);
 
-    button2.setDebounceTicks(100);
+    button2.setTimingP(&BUTTON_TIMING);
     button2.setOnClickListener(this);
     button2.setOnDoubleClickListener(this);
     button2.setOnPressListener(this);
-    button2.setLongPressTicks(3000 /* ms */);
 
 }
 
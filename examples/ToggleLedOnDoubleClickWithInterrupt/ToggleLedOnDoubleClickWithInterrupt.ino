@@ -38,11 +38,17 @@ public:
 
     void update();
 
+    void captureEdge();
+
 private:
     void onDoubleClick(Button& button) override;
 
     DigitalButton button = DigitalButton(INTERRUPT_PIN);
-    volatile byte ledState = LOW;
+    byte ledState = LOW;
+
+    // Interrupt only stores timestamped edges, state machine and listeners run in loop()
+    EdgeCapture<16, 1> edges;
+    int16_t buttonSource = -1;
 };
 
 void ToggleLedOnDoubleClick::onDoubleClick(Button& button) {
@@ -63,24 +69,32 @@ void ToggleLedOnDoubleClick::init() {
     pinMode(LED_PIN, OUTPUT);
     button.setDebounceTicks(10);
     button.setOnDoubleClickListener(this);
+    buttonSource = edges.add(button);
 }
 
 void ToggleLedOnDoubleClick::update() {
-    button.tick();
+    edges.tick();
+}
+
+void ToggleLedOnDoubleClick::captureEdge() {
+    edges.capture(buttonSource, digitalRead(INTERRUPT_PIN) == LOW);
 }
 
 ToggleLedOnDoubleClick toggleLedOnDoubleClick = ToggleLedOnDoubleClick();
 
-void refreshButton() {
-    toggleLedOnDoubleClick.update();
+void onPinChange() {
+    toggleLedOnDoubleClick.captureEdge();
 }
 
 void setup() {
     toggleLedOnDoubleClick.init();
-    attachInterrupt(digitalPinToInterrupt(INTERRUPT_PIN), refreshButton, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(INTERRUPT_PIN), onPinChange, CHANGE);
 }
 
 void loop() {
     // Do some work
     delay(10);
+
+    // Process edges captured meanwhile, even a press shorter than the delay above is not lost
+    toggleLedOnDoubleClick.update();
 }
@@ -56,6 +56,9 @@ private:
 
     AnalogButton button1 = AnalogButton(BUTTON_1_ID, INPUT_PIN, BUTTON_1_ON_PRESS_VOLTAGE);
     AnalogButton button2 = AnalogButton(BUTTON_2_ID, INPUT_PIN, BUTTON_2_ON_PRESS_VOLTAGE);
+
+    // Both buttons share the same pin. Ladder reads it once per tick and decodes both buttons from a single sample.
+    AnalogLadder<2> ladder = AnalogLadder<2>(INPUT_PIN);
 };
 
 void TwoButtons::onClick(Button& button) {
@@ -140,11 +143,13 @@ void TwoButtons::init() {
     button2.setOnClickListener(this);
     button2.setOnDoubleClickListener(this);
     button2.setOnPressListener(this);
+
+    ladder.add(button1);
+    ladder.add(button2);
 }
 
 void TwoButtons::update() {
-    button1.tick();
-    button2.tick();
+    ladder.tick();
 }
 
 TwoButtons twoButtons = TwoButtons();
@@ -0,0 +1,389 @@
+/**
+ *  @file       bounce_replay.cpp
+ *  Project     ObjectButton
+ *  @brief      Replays recorded switch bounce traces and measures detection accuracy and latency.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ObjectButton.h"
+using namespace jsc;
+
+/*
+ * Trace format
+ *
+ * A trace is a text file. Lines starting with '#' are comments, except for ground truth annotations:
+ *
+ *   # intended <start_us> <end_us>
+ *
+ * which tell when the user intended to press and release the button. Other lines hold input transitions:
+ *
+ *   <time_us> <level>
+ *
+ * where level is 1 while the contact is closed (button pressed) and 0 otherwise. Input is open before
+ * the first transition. Captured traces, e.g. exported from a logic analyzer, can be added in this format.
+ */
+
+constexpr static uint8_t INPUT_PIN = 3;
+constexpr static int RELEASED_VOLTAGE = 1023;
+constexpr static int PRESSED_VOLTAGE = 512;
+
+/** Button is ticked once per millisecond, as in a tight loop() */
+constexpr static unsigned long TICK_PERIOD_MS = 1;
+
+/** A press event later than this after intended release is not a response to that press [milliseconds] */
+constexpr static unsigned long MATCH_WINDOW_MS = 100;
+
+struct Transition {
+    unsigned long time; /**< [microseconds] */
+    bool pressed;
+};
+
+struct Interval {
+    unsigned long start; /**< [microseconds] */
+    unsigned long end; /**< [microseconds] */
+};
+
+struct Trace {
+    std::string name;
+    std::vector<Transition> transitions;
+    std::vector<Interval> intended;
+};
+
+/*
+ * Synthetic corpus
+ */
+
+/** Deterministic pseudo-random generator, so the generated corpus does not change between runs */
+class Random {
+public:
+    explicit Random(uint32_t seed) : m_state(seed) {}
+
+    unsigned long between(unsigned long low, unsigned long high) {
+        m_state = m_state * 1664525UL + 1013904223UL;
+        return low + (m_state >> 8) % (high - low + 1);
+    }
+
+private:
+    uint32_t m_state;
+};
+
+/**
+ * @brief Parameters of a synthetic switch model. All times are in microseconds.
+ */
+struct SwitchModel {
+    const char *name;
+    unsigned long minPress, maxPress; /**< Intended press duration */
+    unsigned long minGap, maxGap; /**< Pause between presses */
+    unsigned long maxPressBounce; /**< Longest bounce after contact closes */
+    unsigned long maxReleaseBounce; /**< Longest bounce after contact opens */
+    unsigned long minPulse, maxPulse; /**< Duration of a single bounce pulse */
+    unsigned long glitchesPerSecond; /**< Short contact openings while the button is held */
+};
+
+static const SwitchModel MODELS[] = {
+        {"clean", 60000, 1500000, 300000, 1500000, 0, 0, 0, 0, 0},
+        {"tactile", 60000, 1500000, 300000, 1500000, 5000, 3000, 100, 1500, 0},
+        {"long_bounce", 60000, 1500000, 300000, 1500000, 20000, 15000, 200, 3000, 0},
+        {"noisy_hold", 200000, 1500000, 300000, 1500000, 5000, 3000, 100, 1500, 5},
+        {"fast_taps", 30000, 80000, 80000, 300000, 8000, 5000, 100, 1500, 0},
+};
+
+constexpr static int PRESSES_PER_TRACE = 40;
+
+static void addBounce(Trace &trace, Random &random, const SwitchModel &model,
+                      unsigned long edge, unsigned long window, bool finalLevel) {
+    unsigned long t = edge;
+    bool level = finalLevel;
+    trace.transitions.push_back({t, level});
+    if (window == 0)
+        return;
+
+    unsigned long end = edge + random.between(0, window);
+    while (true) {
+        t += random.between(model.minPulse, model.maxPulse);
+        if (t >= end)
+            break;
+        level = !level;
+        trace.transitions.push_back({t, level});
+    }
+    if (level != finalLevel)
+        trace.transitions.push_back({t, finalLevel});
+}
+
+static Trace generate(const SwitchModel &model, uint32_t seed) {
+    Random random(seed);
+    Trace trace;
+    trace.name = model.name;
+
+    unsigned long t = 100000;
+    for (int i = 0; i < PRESSES_PER_TRACE; i++) {
+        unsigned long start = t;
+        unsigned long end = start + random.between(model.minPress, model.maxPress);
+        trace.intended.push_back({start, end});
+
+        addBounce(trace, random, model, start, model.maxPressBounce, true);
+
+        // glitches while held, away from both edges
+        unsigned long glitches = model.glitchesPerSecond * (end - start) / 1000000;
+        unsigned long last = trace.transitions.back().time;
+        for (unsigned long g = 0; g < glitches; g++) {
+            unsigned long at = random.between(last + 1000, end - 1000);
+            if (at <= last || at + model.maxPulse >= end)
+                continue;
+            trace.transitions.push_back({at, false});
+            last = at + random.between(model.minPulse, model.maxPulse);
+            trace.transitions.push_back({last, true});
+        }
+
+        addBounce(trace, random, model, std::max(end, trace.transitions.back().time + 1),
+                  model.maxReleaseBounce, false);
+        t = trace.transitions.back().time + random.between(model.minGap, model.maxGap);
+    }
+
+    return trace;
+}
+
+static bool save(const Trace &trace, const std::string &path) {
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "# ObjectButton bounce trace: %s (synthetic)\n", trace.name.c_str());
+    for (const Interval &interval : trace.intended)
+        fprintf(file, "# intended %lu %lu\n", interval.start, interval.end);
+    for (const Transition &transition : trace.transitions)
+        fprintf(file, "%lu %d\n", transition.time, transition.pressed ? 1 : 0);
+
+    fclose(file);
+    return true;
+}
+
+static bool load(const std::string &path, Trace &trace) {
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == nullptr)
+        return false;
+
+    size_t slash = path.find_last_of('/');
+    size_t dot = path.find_last_of('.');
+    trace.name = path.substr(slash == std::string::npos ? 0 : slash + 1,
+                             dot == std::string::npos || dot < slash + 1 ? std::string::npos : dot - slash - 1);
+
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        unsigned long start, end, time;
+        int level;
+        if (sscanf(line, "# intended %lu %lu", &start, &end) == 2)
+            trace.intended.push_back({start, end});
+        else if (line[0] != '#' && sscanf(line, "%lu %d", &time, &level) == 2)
+            trace.transitions.push_back({time, level != 0});
+    }
+
+    fclose(file);
+    return true;
+}
+
+/*
+ * Replay
+ */
+
+/**
+ * @brief Listener recording press and release timestamps.
+ *
+ * It does not observe double-clicks, so every press is reported as a press, even a quick second one.
+ */
+class EdgeRecorder : public IButtonEventListener {
+public:
+    bool observes(ButtonEventType type) override {
+        return type != ButtonEventType::DOUBLE_CLICK;
+    }
+
+    void onEvent(Button &button, const ButtonEvent &event) override {
+        if (event.type == ButtonEventType::PRESS)
+            presses.push_back(event.time);
+        else if (event.type == ButtonEventType::RELEASE)
+            releases.push_back(event.time);
+    }
+
+    std::vector<unsigned long> presses;
+    std::vector<unsigned long> releases;
+};
+
+static double percentile(std::vector<unsigned long> values, double fraction) {
+    if (values.empty())
+        return -1;
+    std::sort(values.begin(), values.end());
+    return values[(size_t) (fraction * (values.size() - 1) + 0.5)];
+}
+
+/**
+ * @brief Match detected events to intended edges.
+ *
+ * Each intended edge is matched with the first unused event between the edge and
+ * the start of the next intended press.
+ *
+ * @return latencies of matched events [milliseconds].
+ */
+static std::vector<unsigned long> match(const std::vector<Interval> &intended, const std::vector<unsigned long> &events,
+                                        bool releases) {
+    std::vector<unsigned long> latencies;
+    size_t next = 0;
+    for (size_t i = 0; i < intended.size(); i++) {
+        unsigned long edge = (releases ? intended[i].end : intended[i].start) / 1000;
+        unsigned long limit = i + 1 < intended.size() ? intended[i + 1].start / 1000
+                                                      : intended[i].end / 1000 + MATCH_WINDOW_MS;
+        if (!releases)
+            limit = std::min(limit, intended[i].end / 1000 + MATCH_WINDOW_MS);
+
+        while (next < events.size() && events[next] < edge)
+            next++;
+        if (next < events.size() && events[next] < limit) {
+            latencies.push_back(events[next] - edge);
+            next++;
+        }
+    }
+    return latencies;
+}
+
+template<typename T>
+static void replay(const Trace &trace, const char *buttonType, T &button,
+                   const char *debouncerName, IDebouncer *debouncer, uint8_t debounceTicks, bool lockout = false) {
+    EdgeRecorder recorder;
+    button.reset();
+    button.setDebounceTicks(debounceTicks);
+    button.setDebouncer(debouncer);
+    button.setLockoutDebounce(lockout);
+    button.setEventListener(&recorder);
+
+    unsigned long end = trace.transitions.empty() ? 0 : trace.transitions.back().time / 1000 + 1000;
+    size_t next = 0;
+    bool pressed = false;
+    for (unsigned long now = 0; now <= end; now += TICK_PERIOD_MS) {
+        // input level seen by the tick is the one at the moment of sampling
+        while (next < trace.transitions.size() && trace.transitions[next].time <= now * 1000)
+            pressed = trace.transitions[next++].pressed;
+
+        host().millis = now;
+        host().digitalPin[INPUT_PIN] = pressed ? LOW : HIGH;
+        host().analogPin[INPUT_PIN] = pressed ? PRESSED_VOLTAGE : RELEASED_VOLTAGE;
+        button.tick();
+    }
+
+    std::vector<unsigned long> pressLatencies = match(trace.intended, recorder.presses, false);
+    std::vector<unsigned long> releaseLatencies = match(trace.intended, recorder.releases, true);
+
+    size_t intended = trace.intended.size();
+    printf("bounce_replay,%s,%s,%s,%u,%u,%u,%u,%u,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+           trace.name.c_str(), buttonType, debouncerName, debounceTicks,
+           (unsigned) intended,
+           (unsigned) recorder.presses.size(),
+           (unsigned) (intended - pressLatencies.size()),
+           (unsigned) (recorder.presses.size() - pressLatencies.size()),
+           percentile(pressLatencies, 0),
+           percentile(pressLatencies, 0.5),
+           percentile(pressLatencies, 0.95),
+           percentile(pressLatencies, 1),
+           percentile(releaseLatencies, 0.5),
+           percentile(releaseLatencies, 0.95));
+}
+
+static int usage(const char *program) {
+    fprintf(stderr, "usage: %s TRACE...\n", program);
+    fprintf(stderr, "       %s --generate DIRECTORY\n", program);
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2)
+        return usage(argv[0]);
+
+    if (strcmp(argv[1], "--generate") == 0) {
+        if (argc != 3)
+            return usage(argv[0]);
+        uint32_t seed = 1;
+        for (const SwitchModel &model : MODELS) {
+            std::string path = std::string(argv[2]) + "/" + model.name + ".trace";
+            if (!save(generate(model, seed++), path)) {
+                fprintf(stderr, "cannot write %s\n", path.c_str());
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    printf("benchmark,trace,button,debouncer,debounce_ms,intended,detected,missed,spurious,"
+           "press_latency_min_ms,press_latency_median_ms,press_latency_p95_ms,press_latency_max_ms,"
+           "release_latency_median_ms,release_latency_p95_ms\n");
+
+    const uint8_t debounceSettings[] = {0, 5, 10, 20, 30, DEFAULT_DEBOUNCE_TICKS_MS};
+    DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+    AnalogButton analogButton = AnalogButton(1, INPUT_PIN, PRESSED_VOLTAGE);
+
+    // sample-based strategies replace time-window debounce, every button needs its own instance
+    struct Strategy {
+        const char *name;
+        IDebouncer *digital;
+        IDebouncer *analog;
+    };
+    IntegratorDebouncer<4> integrator4[2];
+    IntegratorDebouncer<8> integrator8[2];
+    ShiftRegisterDebouncer<4> shiftRegister4[2];
+    ShiftRegisterDebouncer<8> shiftRegister8[2];
+    MajorityDebouncer<5> majority5[2];
+    MajorityDebouncer<9> majority9[2];
+    const Strategy strategies[] = {
+            {"integrator_4", &integrator4[0], &integrator4[1]},
+            {"integrator_8", &integrator8[0], &integrator8[1]},
+            {"shift_register_4", &shiftRegister4[0], &shiftRegister4[1]},
+            {"shift_register_8", &shiftRegister8[0], &shiftRegister8[1]},
+            {"majority_5", &majority5[0], &majority5[1]},
+            {"majority_9", &majority9[0], &majority9[1]},
+    };
+
+    for (int i = 1; i < argc; i++) {
+        Trace trace;
+        if (!load(argv[i], trace)) {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+
+        for (uint8_t debounceTicks : debounceSettings) {
+            replay(trace, "DigitalButton", digitalButton, "time_window", nullptr, debounceTicks);
+            replay(trace, "AnalogButton", analogButton, "time_window", nullptr, debounceTicks);
+        }
+
+        for (uint8_t debounceTicks : debounceSettings) {
+            replay(trace, "DigitalButton", digitalButton, "lockout", nullptr, debounceTicks, true);
+            replay(trace, "AnalogButton", analogButton, "lockout", nullptr, debounceTicks, true);
+        }
+
+        for (const Strategy &strategy : strategies) {
+            replay(trace, "DigitalButton", digitalButton, strategy.name, strategy.digital, 0);
+            replay(trace, "AnalogButton", analogButton, strategy.name, strategy.analog, 0);
+        }
+    }
+
+    return 0;
+}
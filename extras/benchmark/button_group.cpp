@@ -0,0 +1,95 @@
+/**
+ *  @file       button_group.cpp
+ *  Project     ObjectButton
+ *  @brief      Host benchmark comparing per-button ticks with ButtonGroup ticks.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ObjectButton.h"
+using namespace jsc;
+
+constexpr static uint16_t MAX_BUTTONS = 256;
+constexpr static unsigned long TICKS = 20000;
+
+/**
+ * Every button is clicked once in 400 ms, each with a different phase,
+ * so the group always contains idle, pressed and released buttons.
+ */
+static void drivePins(uint16_t buttons, unsigned long now) {
+    for (uint16_t i = 0; i < buttons; i++)
+        host().digitalPin[i] = ((now + i * 7) % 400) < 100 ? LOW : HIGH;
+}
+
+template<typename TickFunction>
+static void run(const char *mode, uint16_t buttons, TickFunction tickAll) {
+    host().millis = 0;
+    host().resetCounters();
+
+    double elapsedNs = 0;
+    for (unsigned long t = 0; t < TICKS; t++) {
+        host().millis = t;
+        drivePins(buttons, t);
+
+        auto start = std::chrono::steady_clock::now();
+        tickAll();
+        auto end = std::chrono::steady_clock::now();
+        elapsedNs += std::chrono::duration<double, std::nano>(end - start).count();
+
+    }
+
+    double buttonTicks = (double) TICKS * buttons;
+    printf("button_group,%s,%u,%.2f,%.3f,%.3f\n", mode, buttons,
+           elapsedNs / buttonTicks,
+           host().millisCalls / buttonTicks,
+           host().digitalReadCalls / buttonTicks);
+}
+
+int main() {
+    printf("benchmark,mode,buttons,ns_per_button_tick,millis_per_button_tick,digital_reads_per_button_tick\n");
+
+    const uint16_t sizes[] = {8, 64, 256};
+    for (uint16_t buttons : sizes) {
+        std::vector<DigitalButton> digitalButtons;
+        digitalButtons.reserve(buttons);
+        ButtonGroup<MAX_BUTTONS> group;
+        for (uint16_t i = 0; i < buttons; i++) {
+            digitalButtons.emplace_back(i, true);
+            group.add(digitalButtons.back());
+        }
+
+        run("individual", buttons, [&]() {
+            for (DigitalButton &button : digitalButtons)
+                button.tick();
+        });
+
+        for (DigitalButton &button : digitalButtons)
+            button.reset();
+
+        run("group", buttons, [&]() {
+            group.tick();
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ *  @file       Arduino.h
+ *  Project     ObjectButton
+ *  @brief      Minimal host-side replacement of the Arduino core used by benchmarks.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+/* Host has a single address space, flash reads are plain memory reads */
+#define PROGMEM
+
+/**
+ * @brief Simulated board state shared by the host Arduino functions.
+ *
+ * Benchmarks drive pins and the clock directly and read call counters afterwards,
+ * so the cost of the library can be expressed in hardware accesses per tick.
+ */
+struct HostState {
+    unsigned long millis = 0;
+    unsigned long micros = 0;
+    int digitalPin[256] = {};
+    int analogPin[256] = {};
+
+    unsigned long millisCalls = 0;
+    unsigned long microsCalls = 0;
+    unsigned long digitalReadCalls = 0;
+    unsigned long analogReadCalls = 0;
+    unsigned long flashReadCalls = 0;
+
+    void resetCounters() {
+        millisCalls = 0;
+        microsCalls = 0;
+        digitalReadCalls = 0;
+        analogReadCalls = 0;
+        flashReadCalls = 0;
+    }
+};
+
+inline HostState &host() {
+    static HostState state;
+    return state;
+}
+
+inline unsigned long millis() {
+    host().millisCalls++;
+    return host().millis;
+}
+
+inline unsigned long micros() {
+    host().microsCalls++;
+    return host().micros;
+}
+
+inline int digitalRead(uint8_t pin) {
+    host().digitalReadCalls++;
+    return host().digitalPin[pin];
+}
+
+inline int analogRead(uint8_t pin) {
+    host().analogReadCalls++;
+    return host().analogPin[pin];
+}
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline void *memcpy_P(void *destination, const void *source, size_t size) {
+    host().flashReadCalls++;
+    return memcpy(destination, source, size);
+}
+
+#endif // HOST_ARDUINO_H
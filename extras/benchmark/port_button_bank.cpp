@@ -0,0 +1,85 @@
+/**
+ *  @file       port_button_bank.cpp
+ *  Project     ObjectButton
+ *  @brief      Host benchmark comparing a 16-button panel read pin by pin and through PortButtonBank.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ObjectButton.h"
+using namespace jsc;
+
+constexpr static uint8_t BUTTONS = 16;
+constexpr static unsigned long TICKS = 100000;
+
+/** One button of the panel is clicked every 500 ms, the rest stays idle. */
+static uint16_t panelInput(unsigned long now) {
+    uint8_t active = (now / 500) % BUTTONS;
+    bool pressed = (now % 500) < 120;
+    return pressed ? static_cast<uint16_t>(~(1u << active)) : 0xFFFF;
+}
+
+template<typename TickFunction>
+static void run(const char *mode, TickFunction tickPanel) {
+    host().resetCounters();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long t = 0; t < TICKS; t++) {
+        host().millis = t;
+        tickPanel(t, panelInput(t));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double elapsedNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+    printf("port_button_bank,%s,%u,%.2f,%.3f\n", mode, BUTTONS,
+           elapsedNs / TICKS,
+           (double) host().digitalReadCalls / TICKS);
+}
+
+int main() {
+    printf("benchmark,mode,buttons,ns_per_panel_tick,digital_reads_per_panel_tick\n");
+
+    std::vector<DigitalButton> buttons;
+    buttons.reserve(BUTTONS);
+    for (uint8_t i = 0; i < BUTTONS; i++)
+        buttons.emplace_back(i, true);
+
+    run("digital_read", [&](unsigned long, uint16_t input) {
+        for (uint8_t i = 0; i < BUTTONS; i++)
+            host().digitalPin[i] = (input >> i) & 1;
+        for (DigitalButton &button : buttons)
+            button.tick();
+    });
+
+    PortButtonBank<uint16_t> bank;
+    for (uint8_t i = 0; i < BUTTONS; i++) {
+        buttons[i].reset();
+        bank.attach(i, buttons[i]);
+    }
+
+    run("port_bank", [&](unsigned long now, uint16_t input) {
+        bank.tick(now, input);
+    });
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ *  @file       static_button.cpp
+ *  Project     ObjectButton
+ *  @brief      Host benchmark comparing StaticButton with DigitalButton.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "ObjectButton.h"
+using namespace jsc;
+
+constexpr static uint8_t INPUT_PIN = 3;
+constexpr static unsigned long TICKS = 1000000;
+
+/** Default timing stored in flash, as StaticButton keeps it */
+const ButtonTiming FLASH_TIMING PROGMEM = {
+        DEFAULT_DEBOUNCE_TICKS_MS,
+        DEFAULT_CLICK_TICKS_MS,
+        DEFAULT_LONG_PRESS_TICKS_MS
+};
+
+/** Button is clicked once in 400 ms. */
+template<typename T>
+static void run(const char *type, T &button) {
+    host().resetCounters();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long t = 0; t < TICKS; t++) {
+        host().millis = t;
+        host().digitalPin[INPUT_PIN] = (t % 400) < 100 ? LOW : HIGH;
+        button.tick(t);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double elapsedNs = std::chrono::duration<double, std::nano>(end - start).count();
+
+    printf("static_button,%s,%u,%.2f,%.3f,%.3f\n", type, (unsigned) sizeof(T),
+           elapsedNs / TICKS,
+           (double) host().digitalReadCalls / TICKS,
+           (double) host().flashReadCalls / TICKS);
+}
+
+int main() {
+    printf("benchmark,type,ram_bytes,ns_per_tick,digital_reads_per_tick,flash_reads_per_tick\n");
+
+    DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+    run("DigitalButton", digitalButton);
+
+    DigitalButton flashTimingButton = DigitalButton(INPUT_PIN, true);
+    flashTimingButton.setTimingP(&FLASH_TIMING);
+    run("DigitalButton+setTimingP", flashTimingButton);
+
+    StaticButton<INPUT_PIN> staticButton;
+    run("StaticButton", staticButton);
+
+    return 0;
+}
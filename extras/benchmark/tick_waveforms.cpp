@@ -0,0 +1,189 @@
+/**
+ *  @file       tick_waveforms.cpp
+ *  Project     ObjectButton
+ *  @brief      Host benchmark measuring the cost of Button::tick() for input waveforms.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ObjectButton.h"
+using namespace jsc;
+
+/** Every waveform repeats with this period [milliseconds] */
+constexpr static unsigned long PERIOD_MS = 1000;
+
+/** Time simulated for every button in every run, regardless of the number of buttons [milliseconds] */
+constexpr static unsigned long SIMULATED_MS = 20 * PERIOD_MS;
+
+/** Fewest button ticks timed per run, a few buttons replay the simulated span until they reach it */
+constexpr static unsigned long MIN_BUTTON_TICKS = 2000000;
+
+/** Buttons are spread over this many pins, each pin with a different phase of the waveform */
+constexpr static uint8_t PINS = 200;
+
+constexpr static int RELEASED_VOLTAGE = 1023;
+constexpr static int PRESSED_VOLTAGE = 512;
+
+enum class Waveform {
+    IDLE,
+    BOUNCING,
+    CLICK,
+    DOUBLE_CLICK,
+    LONG_PRESS
+};
+
+static const char *waveformName(Waveform waveform) {
+    switch (waveform) {
+        case Waveform::IDLE: return "idle";
+        case Waveform::BOUNCING: return "bouncing";
+        case Waveform::CLICK: return "click";
+        case Waveform::DOUBLE_CLICK: return "double_click";
+        case Waveform::LONG_PRESS: return "long_press";
+    }
+    return "";
+}
+
+/**
+ * @brief Tell whether a button is pressed at a moment of a waveform.
+ *
+ * Bouncing waveform consists of 30 ms bursts of 3 ms pulses, which are shorter than debounce interval
+ * and must not produce any event. Other waveforms are clean presses.
+ */
+static bool isPressed(Waveform waveform, unsigned long t) {
+    t %= PERIOD_MS;
+    switch (waveform) {
+        case Waveform::IDLE: return false;
+        case Waveform::BOUNCING: return t < 30 && (t / 3) % 2 == 0;
+        case Waveform::CLICK: return t < 100;
+        case Waveform::DOUBLE_CLICK: return t < 80 || (t >= 160 && t < 240);
+        case Waveform::LONG_PRESS: return t < 800;
+    }
+    return false;
+}
+
+static void drivePins(Waveform waveform, uint8_t pins, unsigned long now) {
+    for (uint8_t pin = 0; pin < pins; pin++) {
+        bool pressed = isPressed(waveform, now + pin * 5);
+        host().digitalPin[pin] = pressed ? LOW : HIGH;
+        host().analogPin[pin] = pressed ? PRESSED_VOLTAGE : RELEASED_VOLTAGE;
+    }
+}
+
+/**
+ * @brief Listener counting all events, to check that a waveform produced what it should.
+ */
+class EventCounter : public IButtonEventListener {
+public:
+    void onEvent(Button &button, const ButtonEvent &event) override {
+        events++;
+    }
+
+    unsigned long events = 0;
+};
+
+/**
+ * @brief Measure the cost of reading the clock around a measured block.
+ *
+ * With a few buttons, reading the clock takes longer than ticking them, so this cost is subtracted.
+ */
+static double clockOverheadNs() {
+    constexpr static unsigned long SAMPLES = 100000;
+    double elapsedNs = 0;
+    for (unsigned long i = 0; i < SAMPLES; i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto end = std::chrono::steady_clock::now();
+        elapsedNs += std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    return elapsedNs / SAMPLES;
+}
+
+template<typename T, typename Factory>
+static void run(const char *buttonType, Waveform waveform, uint16_t buttons, double overheadNs, Factory create) {
+    std::vector<T> instances;
+    instances.reserve(buttons);
+    EventCounter counter;
+    for (uint16_t i = 0; i < buttons; i++) {
+        instances.push_back(create(i % PINS));
+        instances.back().setEventListener(&counter);
+    }
+
+    // every button is ticked once per millisecond of the same span, so event counts compare across sizes
+    unsigned long repeats = MIN_BUTTON_TICKS / (SIMULATED_MS * buttons);
+    if (repeats == 0)
+        repeats = 1;
+    uint8_t pins = buttons < PINS ? buttons : PINS;
+    host().resetCounters();
+
+    double elapsedNs = 0;
+    for (unsigned long repeat = 0; repeat < repeats; repeat++) {
+        for (T &button : instances)
+            button.reset();
+
+        for (unsigned long t = 0; t < SIMULATED_MS; t++) {
+            host().millis = t;
+            drivePins(waveform, pins, t);
+
+            auto start = std::chrono::steady_clock::now();
+            for (T &button : instances)
+                button.tick();
+            auto end = std::chrono::steady_clock::now();
+            elapsedNs += std::chrono::duration<double, std::nano>(end - start).count() - overheadNs;
+        }
+    }
+
+    double buttonTicks = (double) SIMULATED_MS * repeats * buttons;
+    printf("tick_waveforms,%s,%s,%u,%.2f,%.0f,%.3f,%.3f,%.3f,%.3f\n", buttonType, waveformName(waveform), buttons,
+           elapsedNs / buttonTicks,
+           buttonTicks / (elapsedNs / 1e9),
+           host().millisCalls / buttonTicks,
+           host().digitalReadCalls / buttonTicks,
+           host().analogReadCalls / buttonTicks,
+           counter.events / ((double) buttons * repeats));
+}
+
+int main() {
+    printf("benchmark,button,waveform,buttons,ns_per_tick,ticks_per_s,"
+           "millis_per_tick,digital_reads_per_tick,analog_reads_per_tick,events_per_button\n");
+
+    const Waveform waveforms[] = {
+            Waveform::IDLE, Waveform::BOUNCING, Waveform::CLICK, Waveform::DOUBLE_CLICK, Waveform::LONG_PRESS
+    };
+    const uint16_t sizes[] = {1, 10, 100, 1000};
+    double overheadNs = clockOverheadNs();
+
+    for (Waveform waveform : waveforms) {
+        for (uint16_t buttons : sizes) {
+            run<DigitalButton>("DigitalButton", waveform, buttons, overheadNs, [](uint8_t pin) {
+                return DigitalButton(pin, true);
+            });
+            run<AnalogButton>("AnalogButton", waveform, buttons, overheadNs, [](uint8_t pin) {
+                return AnalogButton(pin, pin, PRESSED_VOLTAGE);
+            });
+            run<AnalogSensor>("AnalogSensor", waveform, buttons, overheadNs, [](uint8_t pin) {
+                return AnalogSensor(pin, pin, PRESSED_VOLTAGE);
+            });
+        }
+    }
+
+    return 0;
+}
@@ -25,14 +25,34 @@
 #ifndef OBJECT_BUTTON_H
 #define OBJECT_BUTTON_H
 
+#include "base/Clock.h"
+#include "base/ButtonTiming.h"
+#include "base/ButtonGroup.h"
+#include "base/ChordDetector.h"
+#include "base/TickMonitor.h"
+#include "base/EdgeCapture.h"
+#include "base/EventQueue.h"
+#include "base/GestureRecognizer.h"
+#include "base/ButtonCallbacks.h"
+#include "base/InlineCallback.h"
+#include "base/IntegratorDebouncer.h"
+#include "base/ShiftRegisterDebouncer.h"
+#include "base/MajorityDebouncer.h"
+#include "base/LatencyStats.h"
+
 #include "digital/DigitalButton.h"
 #include "digital/DigitalSensor.h"
+#include "digital/PortButtonBank.h"
+#include "digital/StaticButton.h"
 
 #include "analog/AnalogButton.h"
 #include "analog/AnalogSensor.h"
+#include "analog/AnalogLadder.h"
 
 #include "interfaces/IOnClickListener.h"
 #include "interfaces/IOnDoubleClickListener.h"
 #include "interfaces/IOnPressListener.h"
+#include "interfaces/IButtonEventListener.h"
+#include "interfaces/IDebouncer.h"
 
 #endif // OBJECT_BUTTON_H
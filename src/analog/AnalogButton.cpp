@@ -60,7 +60,17 @@ int AnalogButton::getId() {
  * This is a private method called from the state machine. It evaluates whether a button is pressed.
  */
 bool AnalogButton::isButtonPressed() {
-    return abs(analogRead(m_pin) - m_voltage) < m_margin;
+    return isVoltageInRange(analogRead(m_pin));
+}
+
+/**
+ * @brief Evaluate whether a measured voltage belongs to this button.
+ *
+ * @param voltage a voltage returned by the analogRead() function.
+ * @return <code>true</code> if the voltage lies within button voltage +- margin, <code>false</code> otherwise.
+ */
+bool AnalogButton::isVoltageInRange(int voltage) {
+    return abs(voltage - m_voltage) < m_margin;
 }
 
 /**
@@ -73,3 +83,22 @@ bool AnalogButton::isButtonPressed() {
 void AnalogButton::setVoltageMargin(uint16_t margin) {
     m_margin = margin;
 }
+
+/**
+ * @brief Get voltage present on the pin after the button is pressed.
+ *
+ * @return voltage as returned by the analogRead() function.
+ */
+uint16_t AnalogButton::getVoltage() {
+    return m_voltage;
+}
+
+/**
+ * @brief Get voltage margin.
+ *
+ * @return voltage margin.
+ * @see setVoltageMargin(uint16_t margin)
+ */
+uint16_t AnalogButton::getVoltageMargin() {
+    return m_margin;
+}
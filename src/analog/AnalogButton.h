@@ -42,6 +42,12 @@ namespace jsc {
 
         void setVoltageMargin(uint16_t margin);
 
+        uint16_t getVoltage();
+
+        uint16_t getVoltageMargin();
+
+        bool isVoltageInRange(int voltage);
+
     private:
         bool isButtonPressed() override;
 
@@ -56,7 +62,7 @@ namespace jsc {
          * Note: If user gives two buttons the same ID, the code will work, except user won't be able to
          * tell, which button was triggered.
          */
-        int m_buttonId;
+        uint8_t m_buttonId;
 
         /**
          * @brief Voltage present on the pin after button was pressed.
@@ -0,0 +1,198 @@
+/**
+ *  @file       AnalogLadder.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANALOG_LADDER_H
+#define ANALOG_LADDER_H
+
+#include "AnalogButton.h"
+
+namespace jsc {
+    /**
+     * @brief Resistor ladder decoding all analog buttons sharing a pin from a single ADC conversion.
+     *
+     * When each AnalogButton on a shared pin is ticked separately, every button calls <code>analogRead()</code>
+     * on its own. AnalogLadder owns the pin instead: it takes one sample per tick, finds the button whose voltage
+     * window contains the sample and feeds all the buttons' state machines with the result. ADC cost therefore
+     * stays the same no matter how many buttons are attached to the ladder.
+     *
+     * Buttons are kept sorted by their voltage, so the pressed button is found using a binary search.
+     * At most one button is considered pressed at a time. If voltage windows of two buttons overlap,
+     * the button with the closer voltage wins. The search looks no further than the widest voltage margin
+     * of the attached buttons, which is read when a button is added, so set margins before adding buttons.
+     *
+     * @tparam N maximum number of buttons attached to the ladder.
+     */
+    template<uint8_t N>
+    class AnalogLadder {
+    public:
+        explicit AnalogLadder(uint8_t pin);
+
+        bool add(AnalogButton &button);
+
+        uint8_t size() const;
+
+        void tick();
+
+        void tick(unsigned long now);
+
+        void tick(unsigned long now, int voltage);
+
+    private:
+        int16_t findPressedButton(int voltage);
+
+        uint8_t m_pin; /**< Analog input pin shared by all buttons of the ladder */
+
+        AnalogButton *m_buttons[N]; /**< Buttons sorted by their voltage in ascending order */
+
+        uint8_t m_size = 0; /**< Number of buttons attached to the ladder */
+
+        uint16_t m_maxMargin = 0; /**< Widest voltage margin of the attached buttons */
+    };
+
+    /**
+     * @brief Constructor for the class.
+     * @param pin an analog input pin shared by all buttons of the ladder.
+     */
+    template<uint8_t N>
+    AnalogLadder<N>::AnalogLadder(uint8_t pin) : m_pin(pin) {}
+
+    /**
+     * @brief Attach a button to the ladder.
+     *
+     * Once attached, the button should not be ticked on its own. Ladder takes care of it.
+     * Its voltage margin is read now, changing it later does not widen the search.
+     *
+     * @param button an analog button connected to the ladder pin.
+     * @return <code>true</code> if the button was attached, <code>false</code> if the ladder is full.
+     */
+    template<uint8_t N>
+    bool AnalogLadder<N>::add(AnalogButton &button) {
+        if (m_size >= N)
+            return false;
+
+        uint8_t i = m_size++;
+        while (i > 0 && m_buttons[i - 1]->getVoltage() > button.getVoltage()) {
+            m_buttons[i] = m_buttons[i - 1];
+            i--;
+        }
+        m_buttons[i] = &button;
+
+        if (button.getVoltageMargin() > m_maxMargin)
+            m_maxMargin = button.getVoltageMargin();
+        return true;
+    }
+
+    /**
+     * @brief Get number of buttons attached to the ladder.
+     * @return number of attached buttons.
+     */
+    template<uint8_t N>
+    uint8_t AnalogLadder<N>::size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Sample the ladder pin and update state machines of all attached buttons.
+     *
+     * Call this function periodically in your <code>loop()</code> function instead of ticking
+     * each button separately.
+     */
+    template<uint8_t N>
+    void AnalogLadder<N>::tick() {
+        tick(readClock());
+    }
+
+    /**
+     * @brief Sample the ladder pin and update all attached buttons using a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     */
+    template<uint8_t N>
+    void AnalogLadder<N>::tick(unsigned long now) {
+        tick(now, analogRead(m_pin));
+    }
+
+    /**
+     * @brief Update all attached buttons using a voltage sampled by the caller.
+     * @param now current time as returned by readClock().
+     * @param voltage a voltage returned by the analogRead() function.
+     */
+    template<uint8_t N>
+    void AnalogLadder<N>::tick(unsigned long now, int voltage) {
+        int16_t pressedButton = findPressedButton(voltage);
+
+        for (uint8_t i = 0; i < m_size; i++)
+            m_buttons[i]->tick(now, i == pressedButton);
+    }
+
+    /**
+     * @brief Find a button matching the sampled voltage.
+     * @param voltage a voltage returned by the analogRead() function.
+     * @return index of the pressed button or -1 if no button matches the voltage.
+     */
+    template<uint8_t N>
+    int16_t AnalogLadder<N>::findPressedButton(int voltage) {
+        // find the first button with voltage higher than or equal to the sample
+        uint8_t low = 0;
+        uint8_t high = m_size;
+        while (low < high) {
+            uint8_t middle = (low + high) / 2;
+            if (m_buttons[middle]->getVoltage() < voltage)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        /*
+         * A button with a wide margin can contain the sample even if its neighbours do not, so each side
+         * is walked from the insertion point until the first button whose own window contains the sample,
+         * but no further than the widest margin reaches. The closer of the two hits wins.
+         */
+        int16_t pressedButton = -1;
+        uint16_t pressedDistance = 0;
+        for (uint8_t i = low; i < m_size; i++) {
+            uint16_t distance = m_buttons[i]->getVoltage() - voltage;
+            if (distance >= m_maxMargin)
+                break;
+            if (m_buttons[i]->isVoltageInRange(voltage)) {
+                pressedButton = i;
+                pressedDistance = distance;
+                break;
+            }
+        }
+
+        for (uint8_t i = low; i > 0; i--) {
+            uint16_t distance = voltage - m_buttons[i - 1]->getVoltage();
+            if (distance >= m_maxMargin || (pressedButton >= 0 && distance >= pressedDistance))
+                break;
+            if (m_buttons[i - 1]->isVoltageInRange(voltage)) {
+                pressedButton = i - 1;
+                break;
+            }
+        }
+
+        return pressedButton;
+    }
+}
+
+#endif // ANALOG_LADDER_H
@@ -25,13 +25,77 @@
 #include "Button.h"
 using namespace jsc;
 
+const ButtonTiming jsc::DEFAULT_BUTTON_TIMING = {
+        DEFAULT_DEBOUNCE_TICKS_MS,
+        DEFAULT_CLICK_TICKS_MS,
+        DEFAULT_LONG_PRESS_TICKS_MS
+};
+
+const RepeatTiming jsc::DEFAULT_REPEAT_TIMING = {
+        0,
+        200,
+        50,
+        25
+};
+
+static_assert(OBJECT_BUTTON_REPEAT_TIMINGS <= 3, "Repeat profile index does not fit into two bits");
+
+/*
+ * Table of repeat profiles set through setRepeatTiming() and setRepeatTimingP(). A button keeps an index into it,
+ * which costs two bits instead of a pointer. Repeat profiles are meant to be constants, so an entry is never freed.
+ * Bits of the mask are set for profiles stored in flash memory.
+ */
+static const RepeatTiming *repeatTimings[OBJECT_BUTTON_REPEAT_TIMINGS];
+static uint8_t repeatTimingsInFlash;
+
+/**
+ * @brief Compute time remaining until a timeout elapses.
+ *
+ * State machine checks timeouts using "greater than" comparison, so a timeout of <code>ticks</code>
+ * milliseconds is detected <code>ticks + 1</code> milliseconds after it started.
+ *
+ * @param elapsed time elapsed since the timeout started [milliseconds].
+ * @param ticks timeout interval [milliseconds].
+ * @return milliseconds until the timeout is detected, zero if it is already due.
+ */
+static unsigned long timeUntil(unsigned long elapsed, unsigned long ticks) {
+    return elapsed > ticks ? 0 : ticks + 1 - elapsed;
+}
+
+/**
+ * @brief Compute time elapsed since a 16-bit timestamp.
+ *
+ * Unsigned subtraction wraps together with the counter, so the result is correct for intervals
+ * shorter than 65 seconds, even if the clock overflows in between.
+ *
+ * @param timestamp lower 16 bits of a past clock reading.
+ * @param now current time as returned by readClock().
+ * @return milliseconds elapsed since the timestamp.
+ */
+static uint16_t elapsedSince(uint16_t timestamp, unsigned long now) {
+    return static_cast<uint16_t>(static_cast<uint16_t>(now) - timestamp);
+}
+
 /**
  * @brief Constructor for the class.
  * @param pin an input pin to use for the button.
  * @param inputPullUp determines pin state after button press. Set to <code>true</code> if voltage level
  * on input pin is <code>LOW</code> after button is pressed. Otherwise set to <code>false</code>.
  */
-Button::Button(uint8_t pin, bool inputPullUp) : m_pin(pin) {
+Button::Button(uint8_t pin, bool inputPullUp) : m_state(static_cast<uint8_t>(State::BUTTON_NOT_PRESSED)),
+                                                 m_isLongButtonPress(false),
+                                                 m_buttonPressNotified(false),
+                                                 m_speculativeClick(false),
+                                                 m_lockoutDebounce(false),
+                                                 m_pressDurationSaturated(false),
+                                                 m_timingOwned(false),
+                                                 m_timingInFlash(false),
+                                                 m_clicksSuppressed(false),
+                                                 m_repeatCount(0),
+                                                 m_repeatProfile(0),
+                                                 m_clickCount(0),
+                                                 m_maxClickCount(2),
+                                                 m_pin(pin) {
     pinMode(pin, inputPullUp ? INPUT_PULLUP : INPUT);
 }
 
@@ -39,15 +103,18 @@ Button::Button(uint8_t pin, bool inputPullUp) : m_pin(pin) {
  * @brief Set a listener to receive an event after a button is clicked.
  *
  * This listener gets notified each time a button is clicked. A click gesture
- * occurs when a button is pressed and released once within <code>m_clickTicks</code> period.
+ * occurs when a button is pressed and released once within <code>clickTicks</code> period.
  * Until this period elapses, we cannot tell that click event has occurred, because user could
  * still perform a double-click gesture.
  *
+ * If no double-click listener is set, there is nothing to wait for and the click event fires right after
+ * the button is released.
+ *
  * In cases where you work on a project requiring notifications on events as soon as they happen,
  * we do recommend to handle <code>onPress</code> and <code>onRelease</code> events defined
  * in IOnPressListener instead. These events fire almost immediately (after debounce time has elapsed).
  *
- * Button press and release should not occur sooner than defined in <code>m_debounceTicks</code>. This would
+ * Button press and release should not occur sooner than defined in <code>debounceTicks</code>. This would
  * signal random signal changes on input pin, not an user action.
  *
  *
@@ -66,15 +133,15 @@ void Button::setOnClickListener(IOnClickListener *listener) {
  *
  * This listener gets notified each time a button is double-clicked. A double-click gesture
  * occurs when a button is rapidly pressed and released two times in a very short time period,
- * which does not exceed <code>m_clickTicks</code>.
+ * which does not exceed <code>clickTicks</code>.
  *
- * Button press and release should not occur sooner than defined in <code>m_debounceTicks</code>. This would
+ * Button press and release should not occur sooner than defined in <code>debounceTicks</code>. This would
  * signal random signal changes on input pin, not a user action.
  *
  * @param listener object implementing IOnDoubleClickListener interface.
  *
  * @see IOnDoubleClickListener.h
- * @see Button#m_clickTicks
+ * @see ButtonTiming#clickTicks
  * @see setDebounceTicks(uint8_t ticks)
  */
 void Button::setOnDoubleClickListener(IOnDoubleClickListener *listener) {
@@ -91,19 +158,116 @@ void Button::setOnDoubleClickListener(IOnDoubleClickListener *listener) {
  * <code>onPress</code> and <code>onRelease</code> events fire almost immediately (after debounce time elapses)
  * and are suitable for use cases where you need to get event notification as soon as an event occurs.
  *
- * Button press and release should not occur sooner than defined in <code>m_debounceTicks</code>. This would
+ * Button press and release should not occur sooner than defined in <code>debounceTicks</code>. This would
  * signal random signal changes on input pin, not a user action.
  *
  * @param listener object implementing IOnPressListener interface.
  *
  * @see IOnPressListener.h
- * @see Button#m_longPressTicks
+ * @see ButtonTiming#longPressTicks
  * @see setDebounceTicks(uint8_t ticks)
  */
 void Button::setOnPressListener(IOnPressListener *listener) {
     m_onPressListener = listener;
 }
 
+/**
+ * @brief Set a listener to receive all button events in a single function.
+ *
+ * This listener gets notified on every event the button produces, together with a ButtonEvent describing it.
+ * It can be used instead of, or together with, the other listeners. If it does not observe double-clicks,
+ * clicks are reported right after release.
+ *
+ * @param listener object implementing IButtonEventListener interface.
+ *
+ * @see IButtonEventListener.h
+ * @see IButtonEventListener::observes(ButtonEventType type)
+ */
+void Button::setEventListener(IButtonEventListener *listener) {
+    m_eventListener = listener;
+}
+
+/**
+ * @brief Set a table of function callbacks.
+ *
+ * The callback attached to an event type is called straight from the state machine, after the listeners
+ * of that event and before the event listener. A table can be shared by many buttons, it has to outlive them,
+ * or at least stay valid until another table is set. Pass <code>nullptr</code> to stop calling callbacks.
+ *
+ * @param callbacks table of callbacks.
+ *
+ * @see ButtonCallbacks
+ */
+void Button::setCallbacks(const ButtonCallbacks *callbacks) {
+    m_callbacks = callbacks;
+}
+
+/**
+ * @brief Set a debouncing strategy.
+ *
+ * Every raw input sample passes through the debouncer before it reaches the state machine, and time-window debounce
+ * given by <code>debounceTicks</code> is no longer applied. Each button needs its own debouncer instance.
+ * Pass <code>nullptr</code> to go back to time-window debounce.
+ *
+ * @param debouncer object implementing IDebouncer interface.
+ *
+ * @see IDebouncer.h
+ * @see IntegratorDebouncer
+ * @see ShiftRegisterDebouncer
+ * @see MajorityDebouncer
+ */
+void Button::setDebouncer(IDebouncer *debouncer) {
+    m_debouncer = debouncer;
+    if (m_debouncer != nullptr)
+        m_debouncer->reset();
+}
+
+/**
+ * @brief Set a timing profile shared with other buttons.
+ *
+ * Button keeps a reference to the profile, it does not copy it. Any change of the profile applies to all
+ * the buttons using it, so a whole group of buttons can be retuned by a single write. The profile has to
+ * outlive the button, or at least stay valid until another timing is set.
+ *
+ * @param timing timing profile in RAM.
+ *
+ * @see setTimingP(const ButtonTiming *timing)
+ */
+void Button::setTiming(const ButtonTiming &timing) {
+    m_timing = &timing;
+    m_timingOwned = false;
+    m_timingInFlash = false;
+}
+
+/**
+ * @brief Set a timing profile stored in flash memory.
+ *
+ * Same as setTiming(const ButtonTiming &timing), but the profile is declared with <code>PROGMEM</code>
+ * and costs no RAM. It is read with <code>memcpy_P()</code> on every tick.
+ *
+ * @param timing pointer to a timing profile in flash memory.
+ */
+void Button::setTimingP(const ButtonTiming *timing) {
+    m_timing = timing;
+    m_timingOwned = false;
+    m_timingInFlash = true;
+}
+
+/**
+ * @brief Get timing currently used by the button.
+ * @return a copy of the timing profile.
+ */
+ButtonTiming Button::getTiming() {
+    ButtonTiming timing;
+    if (m_timingOwned)
+        timing = m_ownTiming;
+    else if (m_timingInFlash)
+        memcpy_P(&timing, m_timing, sizeof(ButtonTiming));
+    else
+        timing = *m_timing;
+    return timing;
+}
+
 /**
  * @brief Set debounce time interval.
  *
@@ -112,10 +276,16 @@ void Button::setOnPressListener(IOnPressListener *listener) {
  *
  * Default value is defined in #DEFAULT_DEBOUNCE_TICKS_MS.
  *
+ * Button stops using a shared timing profile and keeps a copy of it with the new value instead.
+ * If you configure many buttons the same way, prefer setTiming(const ButtonTiming &timing).
+ *
  * @param ticks a debounce time interval in milliseconds.
  */
 void Button::setDebounceTicks(uint8_t ticks) {
-    m_debounceTicks = ticks;
+    ButtonTiming timing = getTiming();
+    timing.debounceTicks = ticks;
+    m_ownTiming = timing;
+    m_timingOwned = true;
 }
 
 /**
@@ -125,59 +295,267 @@ void Button::setDebounceTicks(uint8_t ticks) {
  * Default value is defined in #DEFAULT_CLICK_TICKS_MS.
  *
  * @param ticks a click time interval in milliseconds.
+ *
+ * @see setDebounceTicks(uint8_t ticks)
  */
 void Button::setClickTicks(uint16_t ticks) {
-    m_clickTicks = ticks;
+    ButtonTiming timing = getTiming();
+    timing.clickTicks = ticks;
+    m_ownTiming = timing;
+    m_timingOwned = true;
 }
 
 /**
  * @brief Set time interval to detect a long press event.
  *
  * Sets a time interval, after which it is safe to assume that a long press event has occurred.
- * Default value is defined in #DEFAULT_LONG_PRESS_TICKS_MS.
+ * Default value is defined in #DEFAULT_LONG_PRESS_TICKS_MS. Longer intervals than #MAX_PRESS_DURATION_MS
+ * are clamped to it, because press duration is not measured beyond that.
  *
  * @param ticks a long press time interval in milliseconds.
+ *
+ * @see setDebounceTicks(uint8_t ticks)
  */
 void Button::setLongPressTicks(uint16_t ticks /* ms */) {
-    m_longPressTicks = ticks;
+    ButtonTiming timing = getTiming();
+    timing.longPressTicks = ticks < MAX_PRESS_DURATION_MS ? ticks : MAX_PRESS_DURATION_MS;
+    m_ownTiming = timing;
+    m_timingOwned = true;
+}
+
+/**
+ * @brief Enable or disable speculative click mode.
+ *
+ * By default, click event is delayed by <code>clickTicks</code>, because a second press could still turn it into
+ * a double-click. In speculative mode, click event fires right after the button is released. If the button is pressed
+ * again within <code>clickTicks</code>, IOnClickListener::onClickCancelled() is sent, followed by
+ * a double-click event.
+ *
+ * Use this mode if your click action is cheap or can be reverted. Click latency drops to debounce time,
+ * while double-click still works.
+ *
+ * @param enabled <code>true</code> to report clicks speculatively, <code>false</code> to wait for click timeout.
+ */
+void Button::setSpeculativeClick(bool enabled) {
+    m_speculativeClick = enabled;
+}
+
+/**
+ * @brief Enable or disable lockout debounce mode.
+ *
+ * By default, press event fires only after the button is held for <code>debounceTicks</code>, so every press
+ * is delayed by the debounce interval. In lockout mode, the first edge from an idle button fires the press event
+ * right away and the input is ignored for <code>debounceTicks</code> afterwards. A release works the same way:
+ * the first edge after the lockout fires the release event, and presses are ignored for <code>debounceTicks</code>.
+ *
+ * Use this mode for inputs which need the lowest latency, e.g. game controllers or emergency stops. Any glitch
+ * on an idle input is reported as a press, so the input must not pick up noise.
+ *
+ * @param enabled <code>true</code> to report edges right away, <code>false</code> to wait for debounce interval.
+ */
+void Button::setLockoutDebounce(bool enabled) {
+    m_lockoutDebounce = enabled;
 }
 
+/**
+ * @brief Set number of clicks in a row after which a click sequence is reported right away.
+ *
+ * By default, the count is two: a double-click is reported on the second release. With a higher count, the click
+ * interval restarts after every release, so the user can go on clicking. Once the sequence settles, a single event
+ * reports it: a click, a double-click, or a multi-click for three and more clicks. When the sequence reaches
+ * the count, it is reported at once, without waiting for the click interval.
+ *
+ * Multi-clicks are detected only if the event listener observes ButtonEventType::MULTI_CLICK.
+ * The count of the sequence is in ButtonEvent::clickCount, or it can be read with getClickCount().
+ *
+ * @param count highest number of clicks in a row, from 2 to #MAX_CLICK_COUNT.
+ */
+void Button::setMaxClickCount(uint8_t count) {
+    m_maxClickCount = count < 2 ? 2 : count > MAX_CLICK_COUNT ? MAX_CLICK_COUNT : count;
+}
+
+/**
+ * @brief Get number of clicks in the current click sequence.
+ *
+ * After the sequence is reported, the count stays readable until the button is pressed again,
+ * so listeners can read it.
+ *
+ * @return number of clicks, zero while the first press of a sequence is held.
+ */
+uint8_t Button::getClickCount() {
+    return m_clickCount;
+}
+
+/**
+ * @brief Enable auto-repeat while the button is held.
+ *
+ * A held button sends a repeat event after <code>delayTicks</code>, and then again and again, faster and faster,
+ * until it is released. IOnPressListener::onRepeat() receives the number of repeats so far, for the event listener
+ * it is in ButtonEvent::clickCount. Once a press has repeated, its release is not reported as a click.
+ *
+ * Repeats are timed from the press timestamp and from each other, so they cost no timer of their own,
+ * and nextDeadline() tells when the next one is due. If the button is ticked late, each tick sends one repeat
+ * until it catches up. The count saturates at #MAX_REPEAT_COUNT, and so does the shortening of the interval.
+ *
+ * Button keeps a reference to the profile, like with setTiming(const ButtonTiming &timing). The profile is
+ * registered in a table shared by all buttons, which holds up to <code>OBJECT_BUTTON_REPEAT_TIMINGS</code>
+ * distinct profiles, and stays registered for good.
+ *
+ * @param timing repeat profile in RAM, e.g. #DEFAULT_REPEAT_TIMING.
+ * @return <code>true</code> if the profile was set, <code>false</code> if the table of profiles is full.
+ * The button keeps its previous profile then.
+ *
+ * @see setRepeatTimingP(const RepeatTiming *timing)
+ */
+bool Button::setRepeatTiming(const RepeatTiming &timing) {
+    return setRepeatProfile(&timing, false);
+}
+
+/**
+ * @brief Enable auto-repeat with a profile stored in flash memory.
+ *
+ * Same as setRepeatTiming(const RepeatTiming &timing), but the profile is declared with <code>PROGMEM</code>
+ * and costs no RAM. It is read with <code>memcpy_P()</code> while the button is held.
+ *
+ * @param timing pointer to a repeat profile in flash memory.
+ * @return <code>true</code> if the profile was set, <code>false</code> if the table of profiles is full.
+ */
+bool Button::setRepeatTimingP(const RepeatTiming *timing) {
+    return setRepeatProfile(timing, true);
+}
+
+/**
+ * @brief Disable auto-repeat. A held button reports a long press only.
+ */
+void Button::clearRepeatTiming() {
+    m_repeatProfile = 0;
+}
+
+/**
+ * @brief Get number of repeats of the current press.
+ *
+ * After the button is released, the count stays readable until the button is pressed again.
+ *
+ * @return number of repeats, saturates at #MAX_REPEAT_COUNT.
+ */
+uint8_t Button::getRepeatCount() {
+    return m_repeatCount;
+}
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+/**
+ * @brief Set statistics receiving edge-to-event latency of this button.
+ *
+ * Every dispatched event is recorded together with the time since the first raw edge of the input transition
+ * which caused it. One object can be shared by several buttons to get statistics of the whole group.
+ * Pass <code>nullptr</code> to stop recording. Available only if the library is built with
+ * <code>OBJECT_BUTTON_LATENCY_STATS</code> defined.
+ *
+ * @param stats object collecting the statistics.
+ *
+ * @see LatencyStats
+ */
+void Button::setLatencyStats(LatencyStats *stats) {
+    m_latencyStats = stats;
+}
+#endif
+
 /**
  * @brief Tell the user if the button is pressed at a given moment.
  * @return <code>true</code> is the button is pressed, <code>false</code> otherwise.
  */
 bool Button::isPressed() {
-    return m_state == State::BUTTON_PRESSED;
+    return getState() == State::BUTTON_PRESSED;
 }
 
 /**
  * @brief Tell the user if the button is long pressed at a given moment.
  *
- * A button is considered to be long pressed after it is held for longer than <code>m_longPressTicks</code>.
+ * A button is considered to be long pressed after it is held for longer than <code>longPressTicks</code>.
  *
  * @return <code>true</code> is the button is long pressed, <code>false</code> otherwise.
  */
 bool Button::isLongPressed() {
-    return m_state == State::BUTTON_PRESSED && m_isLongButtonPress;
+    return getState() == State::BUTTON_PRESSED && m_isLongButtonPress;
+}
+
+/**
+ * @brief Tell the user if the button is held down after debounce.
+ *
+ * Unlike isPressed(), a press is reported as held only after the press event was sent, so a bounce does not count.
+ * The second press of a click sequence counts as well.
+ *
+ * @return <code>true</code> if the button is held, <code>false</code> otherwise.
+ *
+ * @see ChordDetector
+ */
+bool Button::isHeld() {
+    return (getState() == State::BUTTON_PRESSED && m_buttonPressNotified)
+           || getState() == State::BUTTON_DOUBLE_CLICKED;
+}
+
+/**
+ * @brief Tell the user if the state machine waits for a button press.
+ *
+ * An idle button has no pending event. Its state can change only after the input changes,
+ * so it does not need to be ticked until then.
+ *
+ * @return <code>true</code> if the button is idle, <code>false</code> otherwise.
+ */
+bool Button::isIdle() {
+    return getState() == State::BUTTON_NOT_PRESSED;
+}
+
+/**
+ * @brief Drop click events of the gesture in progress.
+ *
+ * Call this function when the gesture was consumed elsewhere, e.g. ChordDetector calls it on member buttons
+ * of a chord. Click, double-click and multi-click events are not sent until the button is pressed again
+ * from idle, and the gesture ends right after release, without waiting for the click interval.
+ * Press, release and long press events are sent as usual. Calling it on an idle button has no effect.
+ */
+void Button::suppressClicks() {
+    m_clicksSuppressed = true;
 }
 
 /**
  * @brief Reset button state.
  *
  * This function resets internal state machine and all the flags to their default values.
- * If you set custom debounce, click or long press intervals, these will also be reset to their
- * default values.
+ * If you set custom debounce, click or long press intervals or a timing profile, the button
+ * will use #DEFAULT_BUTTON_TIMING again. Speculative click and lockout debounce modes and auto-repeat
+ * are disabled, and click sequences end with a double-click again.
+ * Debouncer, if set, stays attached, but forgets its samples.
  */
 void Button::reset() {
-    m_state = State::BUTTON_NOT_PRESSED;
+    setState(State::BUTTON_NOT_PRESSED);
     m_isLongButtonPress = false;
     m_buttonPressNotified = false;
-    m_buttonPressedTime = 0L;
-    m_buttonReleasedTime = 0L;
+    m_speculativeClick = false;
+    m_lockoutDebounce = false;
+    m_pressDurationSaturated = false;
+    m_clicksSuppressed = false;
+    m_clickCount = 0;
+    m_maxClickCount = 2;
+    m_repeatProfile = 0;
+    m_repeatCount = 0;
+    m_buttonPressedTime = 0;
+    m_buttonReleasedTime = 0;
+
+    setTiming(DEFAULT_BUTTON_TIMING);
 
-    m_debounceTicks = DEFAULT_DEBOUNCE_TICKS_MS;
-    m_clickTicks = DEFAULT_CLICK_TICKS_MS;
-    m_longPressTicks = DEFAULT_LONG_PRESS_TICKS_MS;
+    if (m_debouncer != nullptr)
+        m_debouncer->reset();
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+    m_lastTickTime = 0;
+    m_lastTickTimeValid = false;
+    m_lastEdgeTime = 0;
+    m_transitionTime = 0;
+    m_transitionTickInterval = 0;
+    m_lastRawPressed = false;
+    m_transitionPending = false;
+#endif
 }
 
 /**
@@ -186,67 +564,210 @@ void Button::reset() {
  * This function is responsible for updating internal state machine
  * responsible for handling button events and should be called periodically
  * in your <code>loop()</code> function.
+ *
+ * Reads the clock set by setClock(), <code>millis()</code> by default. Timing survives the counter overflow.
+ * While a gesture is in progress, the button has to be ticked at least every 65536 clock ticks (65 seconds),
+ * which is guaranteed if you tick it by nextDeadline().
  */
 void Button::tick() {
-    unsigned long now = millis();
+    tick(readClock());
+}
+
+/**
+ * @brief Update internal state machine using a timestamp provided by the caller.
+ *
+ * Use this variant when you tick many buttons at once and want to read the clock only once,
+ * e.g. from ButtonGroup.
+ *
+ * @param now current time as returned by readClock().
+ *
+ * @see ButtonGroup
+ */
+void Button::tick(unsigned long now) {
+    tick(now, isButtonPressed());
+}
+
+/**
+ * @brief Update internal state machine using an input sampled by the caller.
+ *
+ * Input of the button is not read by this function. Use this variant when a single hardware read
+ * serves more buttons, e.g. from AnalogLadder, where one ADC conversion decodes all the buttons
+ * on a resistor ladder.
+ *
+ * @param now current time as returned by readClock().
+ * @param pressed <code>true</code> if the button is pressed at the moment, <code>false</code> otherwise.
+ *
+ * @see AnalogLadder
+ */
+void Button::tick(unsigned long now, bool pressed) {
+    runStateMachine(now, pressed, getTiming());
+}
 
+/**
+ * @brief Update internal state machine using an input debounced by the caller.
+ *
+ * Same as tick(unsigned long now, bool pressed), but the time-window debounce is skipped for this tick,
+ * because the input is already stable. Timing of the button does not change, click and long press intervals
+ * still apply. Use this variant when the input is debounced elsewhere, e.g. by PortButtonBank.
+ *
+ * @param now current time as returned by readClock().
+ * @param pressed debounced input, <code>true</code> if the button is pressed at the moment.
+ *
+ * @see PortButtonBank
+ */
+void Button::tickDebounced(unsigned long now, bool pressed) {
+    ButtonTiming timing = getTiming();
+    timing.debounceTicks = 0;
+    runStateMachine(now, pressed, timing);
+}
+
+/**
+ * @brief Update internal state machine with timing provided by the caller.
+ *
+ * Derived classes with timing known at compile time pass it in directly, so the timing profile
+ * is not read on every tick.
+ *
+ * @param now current time as returned by readClock().
+ * @param pressed <code>true</code> if the button is pressed at the moment, <code>false</code> otherwise.
+ * @param timing time constraints to detect events with.
+ *
+ * @see StaticButton
+ */
+void Button::runStateMachine(unsigned long now, bool pressed, const ButtonTiming &timing) {
     /**
      * Relative time difference between button press and release
-     * Note: millis() counter overflows in approx. 50 days. When this happens, m_buttonPressedTime will be set to
-     * near-to-max unsigned long value (high positive number), and our check whether this value is higher than
-     * timeDelta will pass. Such situation will trigger false event.
+     * Note: it is computed from 16-bit timestamps, so it survives the millis() counter overflow, but it is only valid
+     * while a gesture is in progress. Timestamps are not meaningful before the first press.
      */
-    unsigned long timeDelta = now - m_buttonPressedTime;
+    uint16_t timeDelta = elapsedSince(m_buttonPressedTime, now);
+    uint8_t debounceTicks = timing.debounceTicks;
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+    trackEdge(pressed, now, debounceTicks);
+#endif
 
-    switch (m_state) {
+    if (m_debouncer != nullptr) {
+        pressed = m_debouncer->update(pressed, now);
+        debounceTicks = 0;
+    }
+
+    switch (getState()) {
         case State::BUTTON_NOT_PRESSED: {
-            if (isButtonPressed()) {
-                m_state = State::BUTTON_PRESSED;
+            // in lockout mode, release bounce must not start a new press
+            if (isReleaseLockedOut() && elapsedSince(m_buttonReleasedTime, now) > debounceTicks)
+                setReleaseLockout(false);
+
+            if (pressed && !isReleaseLockedOut()) {
+                setState(State::BUTTON_PRESSED);
+                m_pressDurationSaturated = false;
+                m_clicksSuppressed = false;
+                m_clickCount = 0;
+                m_repeatCount = 0;
                 m_buttonPressedTime = now;
+
+                if (m_lockoutDebounce) {
+                    m_buttonPressNotified = true;
+                    notify(ButtonEventType::PRESS, now);
+                }
             }
             break;
         }
         case State::BUTTON_PRESSED: {
-            if (isButtonPressed()) {
-                if (timeDelta > m_debounceTicks && !m_buttonPressNotified) {
+            if (pressed) {
+                if (timeDelta > debounceTicks && !m_buttonPressNotified) {
                     m_buttonPressNotified = true;
-                    notifyOnButtonPress();
+                    notify(ButtonEventType::PRESS, now);
                 }
 
-                if (timeDelta > m_longPressTicks && !m_isLongButtonPress) {
+                if (timeDelta > timing.longPressTicks && !m_isLongButtonPress) {
                     m_isLongButtonPress = true;
-                    notifyOnLongPressStart();
+                    notify(ButtonEventType::LONG_PRESS_START, now);
                 }
+
+                if (timeDelta >= MAX_PRESS_DURATION_MS && m_isLongButtonPress)
+                    m_pressDurationSaturated = true;
+
+                if (m_repeatProfile != 0 && m_buttonPressNotified) {
+                    uint16_t anchor = getRepeatAnchor();
+                    uint16_t interval = getRepeatInterval(timing, getRepeatTiming());
+                    if (elapsedSince(anchor, now) > interval) {
+                        // next repeat is timed from this one, as it was due, not as it was seen
+                        m_buttonReleasedTime = anchor + interval;
+                        if (m_repeatCount < MAX_REPEAT_COUNT)
+                            m_repeatCount++;
+                        m_clicksSuppressed = true;
+                        notify(ButtonEventType::REPEAT, now);
+                    }
+                }
+            } else if (m_lockoutDebounce && timeDelta <= debounceTicks && !m_pressDurationSaturated) {
+                // press bounce, input is ignored until the lockout expires
             } else {
-                if (timeDelta <= m_debounceTicks) {
-                    m_state = State::BUTTON_NOT_PRESSED;
+                m_buttonReleasedTime = now;
+                // once the press was reported, a short delta means the 16-bit timestamp wrapped, not a bounce
+                if (timeDelta <= debounceTicks && !m_buttonPressNotified) {
+                    setState(State::BUTTON_NOT_PRESSED);
                 } else {
-                    m_state = State::BUTTON_RELEASED;
-                    m_buttonPressNotified = false;
-                    notifyOnButtonRelease();
+                    setState(State::BUTTON_RELEASED);
+                    m_clickCount = 1;
+                    setReleaseLockout(m_lockoutDebounce);
+                    notify(ButtonEventType::RELEASE, now);
+
+                    // nothing to tell apart from a double-click, finish the gesture right away
+                    if (!isDoubleClickObserved() || m_clicksSuppressed) {
+                        setState(State::BUTTON_NOT_PRESSED);
+                        if (m_isLongButtonPress) {
+                            m_isLongButtonPress = false;
+                            notify(ButtonEventType::LONG_PRESS_END, now);
+                        } else {
+                            notify(ButtonEventType::CLICK, now);
+                        }
+                    } else if (m_speculativeClick && !m_isLongButtonPress) {
+                        notify(ButtonEventType::CLICK, now);
+                    }
                 }
-                m_buttonReleasedTime = now;
             }
             break;
         }
         case State::BUTTON_RELEASED: {
-            if (isButtonPressed() && (now - m_buttonReleasedTime) > m_debounceTicks) {
+            if (pressed && elapsedSince(m_buttonReleasedTime, now) > debounceTicks) {
                 m_buttonPressedTime = now;
-                m_state = State::BUTTON_DOUBLE_CLICKED;
-            } else if (timeDelta > m_longPressTicks) {
+                m_pressDurationSaturated = false;
+                setState(State::BUTTON_DOUBLE_CLICKED);
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+                // second press produces no event, double-click is measured from the second release
+                m_transitionPending = false;
+#endif
+            } else if (m_isLongButtonPress) {
                 m_isLongButtonPress = false;
-                m_state = State::BUTTON_NOT_PRESSED;
-                notifyOnLongPressEnd();
-            } else if (timeDelta > m_clickTicks) {
-                m_state = State::BUTTON_NOT_PRESSED;
-                notifyOnClick();
+                setState(State::BUTTON_NOT_PRESSED);
+                notify(ButtonEventType::LONG_PRESS_END, now);
+            } else if (timeDelta > timing.clickTicks) {
+                setState(State::BUTTON_NOT_PRESSED);
+                if (m_clickCount > 1)
+                    notifyClicks(now);
+                else if (!m_speculativeClick)
+                    notify(ButtonEventType::CLICK, now);
             }
             break;
         }
         case State::BUTTON_DOUBLE_CLICKED: {
-            if (!isButtonPressed() && timeDelta > m_debounceTicks) {
-                m_state = State::BUTTON_NOT_PRESSED;
-                notifyOnDoubleClick();
+            if (pressed && timeDelta >= MAX_PRESS_DURATION_MS)
+                m_pressDurationSaturated = true;
+
+            if (!pressed && (timeDelta > debounceTicks || m_pressDurationSaturated)) {
+                m_buttonReleasedTime = now;
+                setReleaseLockout(m_lockoutDebounce);
+                m_clickCount++;
+                if (m_speculativeClick && m_clickCount == 2)
+                    notify(ButtonEventType::CLICK_CANCELLED, now);
+
+                // click interval starts over, unless the sequence cannot go on
+                if (m_clickCount < m_maxClickCount && isMultiClickObserved() && !m_clicksSuppressed) {
+                    setState(State::BUTTON_RELEASED);
+                } else {
+                    setState(State::BUTTON_NOT_PRESSED);
+                    notifyClicks(now);
+                }
             }
             break;
         }
@@ -254,49 +775,379 @@ void Button::tick() {
 }
 
 /**
- * @brief Notify listener on click event.
+ * @brief Tell the user when the button needs to be ticked again.
+ *
+ * Between deadlines, <code>tick()</code> cannot produce any event unless the input changes. Battery-powered
+ * projects can sleep until the earliest deadline of all buttons or until a pin change interrupt wakes them up,
+ * instead of calling <code>tick()</code> in a busy loop.
+ *
+ * @return milliseconds until the next timeout of the state machine, zero if one is already due,
+ * or #NO_DEADLINE if the button waits for an input change only.
+ */
+unsigned long Button::nextDeadline() {
+    return nextDeadline(readClock());
+}
+
+/**
+ * @brief Tell the user when the button needs to be ticked again, relative to a timestamp provided by the caller.
+ *
+ * @param now current time as returned by readClock().
+ * @return milliseconds until the next timeout of the state machine, zero if one is already due,
+ * or #NO_DEADLINE if the button waits for an input change only.
+ *
+ * @see nextDeadline()
+ */
+unsigned long Button::nextDeadline(unsigned long now) {
+    return computeDeadline(now, getTiming());
+}
+
+/**
+ * @brief Tell when the button needs to be ticked again, with timing provided by the caller.
+ *
+ * @param now current time as returned by readClock().
+ * @param timing time constraints to detect events with.
+ * @return milliseconds until the next timeout of the state machine, zero if one is already due,
+ * or #NO_DEADLINE if the button waits for an input change only.
+ *
+ * @see runStateMachine(unsigned long now, bool pressed, const ButtonTiming &timing)
+ */
+unsigned long Button::computeDeadline(unsigned long now, const ButtonTiming &timing) {
+    uint16_t timeDelta = elapsedSince(m_buttonPressedTime, now);
+    uint8_t debounceTicks = timing.debounceTicks;
+    unsigned long deadline = NO_DEADLINE;
+
+    if (m_debouncer != nullptr) {
+        // debouncer decides on the next samples, they have to be taken right away
+        if (!m_debouncer->isSettled())
+            return 0;
+        debounceTicks = 0;
+    }
+
+    switch (getState()) {
+        case State::BUTTON_NOT_PRESSED: {
+            // a press ignored during the lockout has to be picked up when it expires
+            if (isReleaseLockedOut())
+                deadline = timeUntil(elapsedSince(m_buttonReleasedTime, now), debounceTicks);
+            break;
+        }
+        case State::BUTTON_PRESSED: {
+            // same for a release ignored during the lockout
+            if (m_lockoutDebounce && timeDelta <= debounceTicks && !m_pressDurationSaturated)
+                return timeUntil(timeDelta, debounceTicks);
+
+            if (!m_buttonPressNotified)
+                deadline = timeUntil(timeDelta, debounceTicks);
+            else if (!m_isLongButtonPress)
+                deadline = timeUntil(timeDelta, timing.longPressTicks);
+            else if (!m_pressDurationSaturated)
+                deadline = timeUntil(timeDelta, MAX_PRESS_DURATION_MS - 1);
+
+            if (m_repeatProfile != 0 && m_buttonPressNotified) {
+                unsigned long repeatDeadline = timeUntil(elapsedSince(getRepeatAnchor(), now),
+                                                         getRepeatInterval(timing, getRepeatTiming()));
+                if (repeatDeadline < deadline)
+                    deadline = repeatDeadline;
+            }
+            break;
+        }
+        case State::BUTTON_RELEASED: {
+            if (m_isLongButtonPress)
+                return 0;
+
+            deadline = timeUntil(timeDelta, timing.clickTicks);
+
+            // a second press is accepted only after release debounce elapses
+            uint16_t releaseDelta = elapsedSince(m_buttonReleasedTime, now);
+            if (releaseDelta <= debounceTicks && timeUntil(releaseDelta, debounceTicks) < deadline)
+                deadline = timeUntil(releaseDelta, debounceTicks);
+            break;
+        }
+        case State::BUTTON_DOUBLE_CLICKED: {
+            if (timeDelta <= debounceTicks)
+                deadline = timeUntil(timeDelta, debounceTicks);
+            else if (!m_pressDurationSaturated)
+                deadline = timeUntil(timeDelta, MAX_PRESS_DURATION_MS - 1);
+            break;
+        }
+    }
+
+    return deadline;
+}
+
+/**
+ * @brief Tell if anybody listens to double-click events.
+ *
+ * Click is reported only after <code>clickTicks</code> elapse, because a second press could still turn it into
+ * a double-click. If there is no double-click listener, this wait is pointless and the click is reported
+ * as soon as the button is released.
+ *
+ * @return <code>true</code> if a listener observing double-clicks is set, <code>false</code> otherwise.
  */
-void Button::notifyOnClick() {
-    if (m_onClickListener != nullptr)
-        m_onClickListener->onClick(*this);
+bool Button::isDoubleClickObserved() {
+    return m_onDoubleClickListener != nullptr
+           || (m_eventListener != nullptr && m_eventListener->observes(ButtonEventType::DOUBLE_CLICK))
+           || (m_callbacks != nullptr && m_callbacks->observes(ButtonEventType::DOUBLE_CLICK))
+           || isMultiClickObserved();
 }
 
 /**
- * @brief Notify listener on double-click event.
+ * @brief Tell if anybody listens to multi-click events.
+ *
+ * Multi-clicks are detected only if the maximum click count is higher than two and the event listener
+ * or the callback table observes them. Otherwise, a double-click ends the click sequence.
+ *
+ * @return <code>true</code> if multi-clicks are detected, <code>false</code> otherwise.
  */
-void Button::notifyOnDoubleClick() {
-    if (m_onDoubleClickListener != nullptr)
-        m_onDoubleClickListener->onDoubleClick(*this);
+bool Button::isMultiClickObserved() {
+    return m_maxClickCount > 2
+           && ((m_eventListener != nullptr && m_eventListener->observes(ButtonEventType::MULTI_CLICK))
+               || (m_callbacks != nullptr && m_callbacks->observes(ButtonEventType::MULTI_CLICK)));
 }
 
 /**
- * @brief Notify listener on button press event.
+ * @brief Notify listeners on a finished sequence of two or more clicks.
+ * @param now timestamp of the event [milliseconds].
  */
-void Button::notifyOnButtonPress() {
-    if (m_onPressListener != nullptr)
-        m_onPressListener->onPress(*this);
+void Button::notifyClicks(unsigned long now) {
+    notify(m_clickCount == 2 ? ButtonEventType::DOUBLE_CLICK : ButtonEventType::MULTI_CLICK, now);
 }
 
 /**
- * @brief Notify listener on button release event.
+ * @brief Point the button to a registered repeat profile, register the profile if it is new.
+ * @param timing repeat profile.
+ * @param inFlash <code>true</code> if the profile is stored in flash memory.
+ * @return <code>true</code> on success, <code>false</code> if the profile is new and the table is full.
  */
-void Button::notifyOnButtonRelease() {
-    if (m_onPressListener != nullptr)
-        m_onPressListener->onRelease(*this);
+bool Button::setRepeatProfile(const RepeatTiming *timing, bool inFlash) {
+    for (uint8_t i = 0; i < OBJECT_BUTTON_REPEAT_TIMINGS; i++) {
+        uint8_t flashBit = 1 << i;
+        if (repeatTimings[i] == nullptr) {
+            repeatTimings[i] = timing;
+            if (inFlash)
+                repeatTimingsInFlash |= flashBit;
+        } else if (repeatTimings[i] != timing || ((repeatTimingsInFlash & flashBit) != 0) != inFlash) {
+            continue;
+        }
+
+        m_repeatProfile = i + 1;
+        return true;
+    }
+    return false;
 }
 
 /**
- * @brief Notify listener on long press start event.
+ * @brief Get repeat profile of the button, which has to be set.
+ * @return a copy of the repeat profile.
  */
-void Button::notifyOnLongPressStart() {
-    if (m_onPressListener != nullptr)
-        m_onPressListener->onLongPressStart(*this);
+RepeatTiming Button::getRepeatTiming() {
+    uint8_t index = m_repeatProfile - 1;
+    RepeatTiming timing;
+    if (repeatTimingsInFlash & (1 << index))
+        memcpy_P(&timing, repeatTimings[index], sizeof(RepeatTiming));
+    else
+        timing = *repeatTimings[index];
+    return timing;
 }
 
 /**
- * @brief Notify listener on long press end event.
+ * @brief Get the timestamp the next repeat is timed from.
+ * @return press time before the first repeat, time the latest repeat was due afterwards.
  */
-void Button::notifyOnLongPressEnd() {
-    if (m_onPressListener != nullptr)
-        m_onPressListener->onLongPressEnd(*this);
+uint16_t Button::getRepeatAnchor() {
+    return m_repeatCount == 0 ? m_buttonPressedTime : m_buttonReleasedTime;
 }
+
+/**
+ * @brief Get time between the previous repeat, or the press, and the next repeat.
+ *
+ * Interval shrinks linearly with the repeat count until it reaches the minimum, so it is computed
+ * from the count alone, without a timer. Once the count saturates, the interval stops shrinking.
+ *
+ * @param timing timing profile of the button, its long press interval is the default repeat delay.
+ * @param repeatTiming repeat profile of the button.
+ * @return the interval [milliseconds].
+ */
+uint16_t Button::getRepeatInterval(const ButtonTiming &timing, const RepeatTiming &repeatTiming) {
+    if (m_repeatCount == 0)
+        return repeatTiming.delayTicks != 0 ? repeatTiming.delayTicks : timing.longPressTicks;
+
+    uint32_t shortening = static_cast<uint32_t>(m_repeatCount - 1) * repeatTiming.accelerationTicks;
+    if (shortening + repeatTiming.minIntervalTicks >= repeatTiming.intervalTicks)
+        return repeatTiming.minIntervalTicks;
+    return repeatTiming.intervalTicks - shortening;
+}
+
+/**
+ * @brief Notify listeners on an event.
+ *
+ * Event is passed to the listener interface handling it and to the event listener, if they are set.
+ * Click events are dropped while clicks are suppressed.
+ *
+ * @param type event type.
+ * @param now timestamp of the event [milliseconds].
+ */
+void Button::notify(ButtonEventType type, unsigned long now) {
+    if (m_clicksSuppressed && (type == ButtonEventType::CLICK || type == ButtonEventType::DOUBLE_CLICK
+                               || type == ButtonEventType::MULTI_CLICK))
+        return;
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+    if (m_latencyStats != nullptr)
+        m_latencyStats->record(type, elapsedSince(m_transitionTime, now), m_transitionTickInterval);
+    m_transitionPending = false;
+#endif
+
+    switch (type) {
+        case ButtonEventType::PRESS:
+            if (m_onPressListener != nullptr)
+                m_onPressListener->onPress(*this);
+            break;
+        case ButtonEventType::RELEASE:
+            if (m_onPressListener != nullptr)
+                m_onPressListener->onRelease(*this);
+            break;
+        case ButtonEventType::CLICK:
+            if (m_onClickListener != nullptr)
+                m_onClickListener->onClick(*this);
+            break;
+        case ButtonEventType::CLICK_CANCELLED:
+            if (m_onClickListener != nullptr)
+                m_onClickListener->onClickCancelled(*this);
+            break;
+        case ButtonEventType::DOUBLE_CLICK:
+            if (m_onDoubleClickListener != nullptr)
+                m_onDoubleClickListener->onDoubleClick(*this);
+            break;
+        case ButtonEventType::LONG_PRESS_START:
+            if (m_onPressListener != nullptr)
+                m_onPressListener->onLongPressStart(*this);
+            break;
+        case ButtonEventType::LONG_PRESS_END:
+            if (m_onPressListener != nullptr)
+                m_onPressListener->onLongPressEnd(*this);
+            break;
+        case ButtonEventType::MULTI_CLICK:
+            // reported through the event listener and callbacks only
+            break;
+        case ButtonEventType::REPEAT:
+            if (m_onPressListener != nullptr)
+                m_onPressListener->onRepeat(*this, m_repeatCount);
+            break;
+    }
+
+    if (m_callbacks != nullptr)
+        m_callbacks->call(*this, type);
+
+    if (m_eventListener == nullptr)
+        return;
+
+    ButtonEvent event;
+    event.type = type;
+    event.buttonId = getId();
+    event.time = now;
+
+    // press is still in progress for these events, other events follow a release
+    if (type == ButtonEventType::PRESS || type == ButtonEventType::LONG_PRESS_START)
+        event.pressDuration = elapsedSince(m_buttonPressedTime, now);
+    else if (type == ButtonEventType::REPEAT)
+        event.pressDuration = m_pressDurationSaturated ? MAX_PRESS_DURATION_MS : elapsedSince(m_buttonPressedTime, now);
+    else
+        event.pressDuration = getPressDuration();
+
+    if (type == ButtonEventType::CLICK)
+        event.clickCount = 1;
+    else if (type == ButtonEventType::DOUBLE_CLICK || type == ButtonEventType::MULTI_CLICK)
+        event.clickCount = m_clickCount;
+    else if (type == ButtonEventType::REPEAT)
+        event.clickCount = m_repeatCount;
+    else
+        event.clickCount = 0;
+
+    m_eventListener->onEvent(*this, event);
+}
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+/**
+ * @brief Track raw input edges for latency statistics.
+ *
+ * The first raw edge of a transition is remembered together with the tick interval at which it was seen.
+ * The transition ends when an event is dispatched, or when the input settles back at the level the state machine
+ * already accepted, e.g. after a glitch on an idle input.
+ *
+ * @param pressed raw input level, before any debouncer.
+ * @param now current time as returned by readClock().
+ * @param debounceTicks time the input has to be stable to settle [milliseconds].
+ */
+void Button::trackEdge(bool pressed, unsigned long now, uint8_t debounceTicks) {
+    uint16_t tickInterval = m_lastTickTimeValid ? elapsedSince(m_lastTickTime, now) : 0;
+    m_lastTickTime = now;
+    m_lastTickTimeValid = true;
+
+    if (pressed != m_lastRawPressed) {
+        m_lastRawPressed = pressed;
+        m_lastEdgeTime = now;
+        if (!m_transitionPending) {
+            m_transitionPending = true;
+            m_transitionTime = now;
+            m_transitionTickInterval = tickInterval;
+        }
+        return;
+    }
+
+    bool acceptedPressed = getState() == State::BUTTON_PRESSED || getState() == State::BUTTON_DOUBLE_CLICKED;
+    if (m_transitionPending && pressed == acceptedPressed && elapsedSince(m_lastEdgeTime, now) > debounceTicks)
+        m_transitionPending = false;
+}
+#endif
+
+/**
+ * @brief Get current state of the state machine.
+ * @return state unpacked from the state byte.
+ */
+Button::State Button::getState() {
+    return static_cast<State>(m_state);
+}
+
+/**
+ * @brief Transition the state machine into a new state.
+ * @param state new state of the state machine.
+ */
+void Button::setState(State state) {
+    m_state = static_cast<uint8_t>(state);
+}
+
+/**
+ * @brief Tell whether presses are ignored after a release in lockout mode.
+ *
+ * Release lockout shares a bit with the press notification flag, which is not used outside the pressed state.
+ *
+ * @return <code>true</code> while the release lockout is set, meaningful only outside the pressed state.
+ */
+bool Button::isReleaseLockedOut() {
+    return m_buttonPressNotified;
+}
+
+/**
+ * @brief Set or clear the release lockout. Also clears the press notification flag, as the press is over.
+ * @param locked <code>true</code> to ignore presses until the debounce interval since release elapses.
+ */
+void Button::setReleaseLockout(bool locked) {
+    m_buttonPressNotified = locked;
+}
+
+/**
+ * @brief Get duration of the last finished press.
+ *
+ * Timestamps are only 16 bits wide, so a long press which lasted for #MAX_PRESS_DURATION_MS or more
+ * is reported as #MAX_PRESS_DURATION_MS.
+ *
+ * @return time between the last button press and release [milliseconds].
+ */
+uint16_t Button::getPressDuration() {
+    if (m_pressDurationSaturated)
+        return MAX_PRESS_DURATION_MS;
+
+    uint16_t duration = m_buttonReleasedTime - m_buttonPressedTime;
+    return duration < MAX_PRESS_DURATION_MS ? duration : MAX_PRESS_DURATION_MS;
+}
+
@@ -30,6 +30,26 @@
 #include "../interfaces/IOnPressListener.h"
 #include "../interfaces/IOnClickListener.h"
 #include "../interfaces/IOnDoubleClickListener.h"
+#include "../interfaces/IButtonEventListener.h"
+#include "../interfaces/IDebouncer.h"
+#include "ButtonTiming.h"
+#include "ButtonCallbacks.h"
+#include "Clock.h"
+#include "LatencyStats.h"
+
+/**
+ * Number of distinct repeat profiles that can be set through Button::setRepeatTiming() and
+ * Button::setRepeatTimingP(). A button refers to its profile by an index into a table of registered profiles,
+ * which has at most 3 entries.
+ */
+#ifndef OBJECT_BUTTON_REPEAT_TIMINGS
+#define OBJECT_BUTTON_REPEAT_TIMINGS 3
+#endif
+
+/*
+ * Define OBJECT_BUTTON_LATENCY_STATS in compiler flags of the whole build to let buttons record edge-to-event
+ * latency into a LatencyStats object. Layout of Button changes with it, so it must not be defined in a sketch only.
+ */
 
 namespace jsc {
     /** Milliseconds that have to pass by before a button press is assumed safe */
@@ -41,6 +61,24 @@ namespace jsc {
     /** Milliseconds that have to pass by before a long button press is detected */
     constexpr static int DEFAULT_LONG_PRESS_TICKS_MS = 500;
 
+    /** Returned by Button::nextDeadline() when a button waits for an input change only */
+    constexpr static unsigned long NO_DEADLINE = static_cast<unsigned long>(-1);
+
+    /** Highest click count Button::setMaxClickCount() accepts */
+    constexpr static uint8_t MAX_CLICK_COUNT = 15;
+
+    /** Longest press duration reported in a ButtonEvent, longer presses saturate to this value [milliseconds] */
+    constexpr static uint16_t MAX_PRESS_DURATION_MS = 60000;
+
+    /** Highest repeat count Button::getRepeatCount() reports, further repeats keep this count */
+    constexpr static uint8_t MAX_REPEAT_COUNT = 15;
+
+    /** Timing profile used by buttons which have no other timing set */
+    extern const ButtonTiming DEFAULT_BUTTON_TIMING;
+
+    /** Repeat profile starting at long press, with intervals shrinking from 200 to 50 milliseconds */
+    extern const RepeatTiming DEFAULT_REPEAT_TIMING;
+
     /**
      * Main component for handling click, double-click and press gestures.
      */
@@ -56,40 +94,98 @@ namespace jsc {
 
         void setOnPressListener(IOnPressListener *listener);
 
+        void setEventListener(IButtonEventListener *listener);
+
+        void setCallbacks(const ButtonCallbacks *callbacks);
+
+        void setDebouncer(IDebouncer *debouncer);
+
+        void setTiming(const ButtonTiming &timing);
+
+        void setTimingP(const ButtonTiming *timing);
+
+        ButtonTiming getTiming();
+
         void setDebounceTicks(uint8_t ticks);
 
         void setClickTicks(uint16_t ticks);
 
         void setLongPressTicks(uint16_t ticks);
 
+        void setSpeculativeClick(bool enabled);
+
+        void setLockoutDebounce(bool enabled);
+
+        void setMaxClickCount(uint8_t count);
+
+        uint8_t getClickCount();
+
+        bool setRepeatTiming(const RepeatTiming &timing);
+
+        bool setRepeatTimingP(const RepeatTiming *timing);
+
+        void clearRepeatTiming();
+
+        uint8_t getRepeatCount();
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+        void setLatencyStats(LatencyStats *stats);
+#endif
+
         bool isPressed();
 
         bool isLongPressed();
 
-        void reset();
+        bool isHeld();
+
+        bool isIdle();
+
+        void suppressClicks();
+
+        virtual void reset();
 
         void tick();
 
+        void tick(unsigned long now);
+
+        void tick(unsigned long now, bool pressed);
+
+        void tickDebounced(unsigned long now, bool pressed);
+
+        unsigned long nextDeadline();
+
+        unsigned long nextDeadline(unsigned long now);
+
     protected:
         /* Avoid initializing this class */
         Button(uint8_t pin, bool inputPullUp);
 
-        uint8_t m_pin; /**< Input pin bound with this button instance */
+        void runStateMachine(unsigned long now, bool pressed, const ButtonTiming &timing);
+
+        unsigned long computeDeadline(unsigned long now, const ButtonTiming &timing);
 
     private:
         virtual bool isButtonPressed() = 0;
 
-        void notifyOnClick();
+        bool isDoubleClickObserved();
+
+        bool isMultiClickObserved();
+
+        void notifyClicks(unsigned long now);
+
+        bool setRepeatProfile(const RepeatTiming *timing, bool inFlash);
 
-        void notifyOnDoubleClick();
+        RepeatTiming getRepeatTiming();
 
-        void notifyOnButtonPress();
+        uint16_t getRepeatAnchor();
 
-        void notifyOnButtonRelease();
+        uint16_t getRepeatInterval(const ButtonTiming &timing, const RepeatTiming &repeatTiming);
 
-        void notifyOnLongPressStart();
+        void notify(ButtonEventType type, unsigned long now);
 
-        void notifyOnLongPressEnd();
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+        void trackEdge(bool pressed, unsigned long now, uint8_t debounceTicks);
+#endif
 
         /**
          * Pointer to object listening to click events. If event listener is not set,
@@ -115,50 +211,222 @@ namespace jsc {
          */
         IOnPressListener *m_onPressListener = nullptr;
 
-        /*
-        * Following variables are used to define time constraints necessary to properly detect events.
-        * These values can be overridden using dedicated functions.
-        */
-        uint8_t m_debounceTicks = DEFAULT_DEBOUNCE_TICKS_MS; /**< Sets debounce time to default [milliseconds] */
-        uint16_t m_clickTicks = DEFAULT_CLICK_TICKS_MS; /**< Sets time to detect click event to default [milliseconds] */
-        uint16_t m_longPressTicks = DEFAULT_LONG_PRESS_TICKS_MS; /**< Sets time to detect long press event to default [milliseconds] */
+        /**
+         * Pointer to object listening to all events. If event listener is not set,
+         * such event won't be broadcast.
+         *
+         * @see setEventListener(IButtonEventListener *listener)
+         */
+        IButtonEventListener *m_eventListener = nullptr;
 
         /**
-         * After you press a button for longer than <code>longPressTicks</code>, a button is considered long pressed.
-         * Our state machine does not have separate long press state. Instead it just sets this flag to <code>true</code>.
+         * Pointer to a table of function callbacks, called directly on every event.
+         * If it is not set, no callback is called.
          *
-         * @see Button::m_longPressTicks
-         * @see isLongPressed()
+         * @see setCallbacks(const ButtonCallbacks *callbacks)
          */
-        bool m_isLongButtonPress = false;
+        const ButtonCallbacks *m_callbacks = nullptr;
 
         /**
-         * This flag helps us determine if an <code>onPress</code> event was already sent. It is necessary
-         * to avoid sending this event each time our state machine's <code>tick()</code> function is called.
+         * Pointer to a debouncing strategy filtering the input. If it is not set, the state machine uses
+         * time-window debounce given by ButtonTiming::debounceTicks.
          *
-         * @see tick()
+         * @see setDebouncer(IDebouncer *debouncer)
          */
-        bool m_buttonPressNotified = false;
+        IDebouncer *m_debouncer = nullptr;
+
+        /*
+         * Time constraints necessary to properly detect events. A button either points to a profile shared with
+         * other buttons, or keeps its own copy in the same place once a per-button setter is called.
+         */
+        union {
+            /**
+             * Profile shared with other buttons, used unless <code>m_timingOwned</code> is set.
+             *
+             * @see setTiming(const ButtonTiming &timing)
+             */
+            const ButtonTiming *m_timing = &DEFAULT_BUTTON_TIMING;
+
+            /**
+             * Timing of this button only, used while <code>m_timingOwned</code> is set.
+             *
+             * @see setDebounceTicks(uint8_t ticks)
+             */
+            ButtonTiming m_ownTiming;
+        };
 
         /**
          * @brief States into which our state machine could transition into.
          */
-        enum class State {
+        enum class State : uint8_t {
             BUTTON_NOT_PRESSED,
             BUTTON_PRESSED,
             BUTTON_RELEASED,
             BUTTON_DOUBLE_CLICKED
         };
 
+        State getState();
+
+        void setState(State state);
+
+        bool isReleaseLockedOut();
+
+        void setReleaseLockout(bool locked);
+
+        uint16_t getPressDuration();
+
+        /*
+         * Timestamps hold the lower 16 bits of millis(). Every timeout is compared against time elapsed since one
+         * of them, a single wrapping subtraction, which stays correct across the counter overflow as long as
+         * the interval is shorter than 65 seconds. Only a press can last longer, therefore its duration saturates.
+         *
+         * A timestamp is read only while it is valid, which the state tells: press time from a press until
+         * the gesture ends, release time in the released state, or while the release lockout is set.
+         * Neither is compared against its initial zero value, so timing does not depend on the time since boot.
+         *
+         * While a press repeats, release time holds the time the latest repeat was due instead. Every repeat
+         * is timed from the previous one, so repeats go on beyond 65 seconds and do not drift.
+         */
+        uint16_t m_buttonPressedTime = 0; /**< Captures timestamp when the button was pressed [milliseconds] */
+        uint16_t m_buttonReleasedTime = 0; /**< Captures timestamp when the button was released [milliseconds] */
+
+        /*
+         * State of the state machine and its flags are packed into bit-fields.
+         */
+
         /**
          * This variable holds current state of our state machine. By default it's "button not pressed".
          *
          * @see enum class State
          */
-        State m_state = State::BUTTON_NOT_PRESSED;
+        uint8_t m_state : 2;
 
-        unsigned long m_buttonPressedTime = 0L; /**< Captures timestamp when the button was pressed [milliseconds] */
-        unsigned long m_buttonReleasedTime = 0L; /**< Captures timestamp when the button was released [milliseconds] */
+        /**
+         * After you press a button for longer than <code>longPressTicks</code>, a button is considered long pressed.
+         * Our state machine does not have separate long press state. Instead it just sets this flag to <code>true</code>.
+         *
+         * @see ButtonTiming::longPressTicks
+         * @see isLongPressed()
+         */
+        bool m_isLongButtonPress : 1;
+
+        /**
+         * This flag helps us determine if an <code>onPress</code> event was already sent. It is necessary
+         * to avoid sending this event each time our state machine's <code>tick()</code> function is called.
+         *
+         * It is read only in the pressed state and cleared on release. In the other states, the same bit is set
+         * while presses are ignored after a release in lockout mode, so the lockout needs no flag of its own.
+         * Release timestamp is meaningful only while the release lockout is set.
+         *
+         * @see tick()
+         * @see isReleaseLockedOut()
+         */
+        bool m_buttonPressNotified : 1;
+
+        /**
+         * In speculative mode, click event is sent right after release and later cancelled
+         * if the release turns out to be a part of a double-click.
+         *
+         * @see setSpeculativeClick(bool enabled)
+         */
+        bool m_speculativeClick : 1;
+
+        /**
+         * In lockout mode, press and release events are sent on the first edge and the input is ignored
+         * for the debounce interval afterwards.
+         *
+         * @see setLockoutDebounce(bool enabled)
+         */
+        bool m_lockoutDebounce : 1;
+
+        /**
+         * Set when a press, including the second press of a double-click, lasts for #MAX_PRESS_DURATION_MS.
+         * Press duration is no longer measured afterwards, because the 16-bit timestamp would overflow.
+         *
+         * @see getPressDuration()
+         */
+        bool m_pressDurationSaturated : 1;
+
+        /**
+         * Set when the button keeps its own timing in <code>m_ownTiming</code> instead of pointing to a profile.
+         *
+         * @see setDebounceTicks(uint8_t ticks)
+         */
+        bool m_timingOwned : 1;
+
+        /**
+         * Set when <code>m_timing</code> points to flash memory and has to be read with <code>memcpy_P()</code>.
+         *
+         * @see setTimingP(const ButtonTiming *timing)
+         */
+        bool m_timingInFlash : 1;
+
+        /**
+         * Set when the current gesture was consumed elsewhere, e.g. by a chord. Click events of the gesture
+         * are dropped.
+         *
+         * @see suppressClicks()
+         */
+        bool m_clicksSuppressed : 1;
+
+        /**
+         * Number of repeats of the current press, or of the last one once it is released.
+         * Saturates at #MAX_REPEAT_COUNT.
+         *
+         * @see getRepeatCount()
+         */
+        uint8_t m_repeatCount : 4;
+
+        /**
+         * Auto-repeat profile as an index into the table of registered profiles, shifted by one.
+         * Zero means that a held button does not repeat.
+         *
+         * @see setRepeatTiming(const RepeatTiming &timing)
+         */
+        uint8_t m_repeatProfile : 2;
+
+        /**
+         * Number of clicks in the current sequence, or in the last one once it is over.
+         *
+         * @see getClickCount()
+         */
+        uint8_t m_clickCount : 4;
+
+        /**
+         * Sequence of clicks is reported as soon as it reaches this count. Two means that a double-click
+         * is reported right away and multi-clicks are not detected.
+         *
+         * @see setMaxClickCount(uint8_t count)
+         */
+        uint8_t m_maxClickCount : 4;
+
+    protected:
+        /* Placed next to the packed flags, so that it takes no padding of its own */
+        uint8_t m_pin; /**< Input pin bound with this button instance */
+
+    private:
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+        /**
+         * Pointer to statistics receiving latency of dispatched events. If it is not set, latency is not recorded.
+         *
+         * @see setLatencyStats(LatencyStats *stats)
+         */
+        LatencyStats *m_latencyStats = nullptr;
+
+        uint16_t m_lastTickTime = 0; /**< Timestamp of the previous tick [milliseconds] */
+        bool m_lastTickTimeValid = false; /**< Set after the first tick, tick interval is measured from then on */
+        uint16_t m_lastEdgeTime = 0; /**< Timestamp of the last raw input change [milliseconds] */
+        uint16_t m_transitionTime = 0; /**< Timestamp of the first raw edge of the current transition [milliseconds] */
+        uint16_t m_transitionTickInterval = 0; /**< Tick interval at the first raw edge [milliseconds] */
+        bool m_lastRawPressed = false; /**< Raw input level seen by the previous tick */
+
+        /**
+         * Set after the first raw edge of a transition, until the state machine accepts the transition or the input
+         * settles back. Further edges, i.e. bounces, do not move the transition timestamp meanwhile.
+         */
+        bool m_transitionPending = false;
+#endif
     };
 }
 
@@ -0,0 +1,120 @@
+/**
+ *  @file       ButtonCallbacks.cpp
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ButtonCallbacks.h"
+using namespace jsc;
+
+/**
+ * @brief Attach a callback to an event type.
+ * @param type event type.
+ * @param callback function to be called on the event, or <code>nullptr</code> to detach the current one.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::set(ButtonEventType type, ButtonCallback callback, void *context) {
+    uint8_t index = static_cast<uint8_t>(type);
+    m_callbacks[index] = callback;
+    m_contexts[index] = context;
+}
+
+/**
+ * @brief Attach a callback to click events.
+ * @param callback function to be called on click.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnClick(ButtonCallback callback, void *context) {
+    set(ButtonEventType::CLICK, callback, context);
+}
+
+/**
+ * @brief Attach a callback to double-click events.
+ * @param callback function to be called on double-click.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnDoubleClick(ButtonCallback callback, void *context) {
+    set(ButtonEventType::DOUBLE_CLICK, callback, context);
+}
+
+/**
+ * @brief Attach a callback to press events.
+ * @param callback function to be called on press.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnPress(ButtonCallback callback, void *context) {
+    set(ButtonEventType::PRESS, callback, context);
+}
+
+/**
+ * @brief Attach a callback to release events.
+ * @param callback function to be called on release.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnRelease(ButtonCallback callback, void *context) {
+    set(ButtonEventType::RELEASE, callback, context);
+}
+
+/**
+ * @brief Attach a callback to long press start events.
+ * @param callback function to be called when long press starts.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnLongPressStart(ButtonCallback callback, void *context) {
+    set(ButtonEventType::LONG_PRESS_START, callback, context);
+}
+
+/**
+ * @brief Attach a callback to long press end events.
+ * @param callback function to be called when long press ends.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void ButtonCallbacks::setOnLongPressEnd(ButtonCallback callback, void *context) {
+    set(ButtonEventType::LONG_PRESS_END, callback, context);
+}
+
+/**
+ * @brief Attach a callback to multi-click events.
+ *
+ * The callback can read the number of clicks with Button::getClickCount().
+ *
+ * @param callback function to be called on three or more clicks in a row.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ *
+ * @see Button::setMaxClickCount(uint8_t count)
+ */
+void ButtonCallbacks::setOnMultiClick(ButtonCallback callback, void *context) {
+    set(ButtonEventType::MULTI_CLICK, callback, context);
+}
+
+/**
+ * @brief Attach a callback to repeat events.
+ *
+ * The callback can read the number of repeats with Button::getRepeatCount().
+ *
+ * @param callback function to be called on every repeat while the button is held.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ *
+ * @see Button::setRepeatTiming(const RepeatTiming &timing)
+ */
+void ButtonCallbacks::setOnRepeat(ButtonCallback callback, void *context) {
+    set(ButtonEventType::REPEAT, callback, context);
+}
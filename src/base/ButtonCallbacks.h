@@ -0,0 +1,119 @@
+/**
+ *  @file       ButtonCallbacks.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUTTON_CALLBACKS_H
+#define BUTTON_CALLBACKS_H
+
+#include "ButtonEvent.h"
+#include "InlineCallback.h"
+
+namespace jsc {
+    /**
+     * @brief Table of plain function callbacks, one per event type.
+     *
+     * Handlers do not need to implement a listener interface. Any free function (or captureless lambda) with
+     * ButtonCallback signature can be attached to an event type together with an arbitrary context pointer.
+     * Capture-light lambdas can be attached through InlineCallback, no heap is used either way.
+     *
+     * Button keeps a pointer to the table and calls the callback of an event straight from the state machine,
+     * without a virtual call. Callbacks receive the button, so one table can serve many buttons, and each button
+     * pays for a single pointer only. Give a button its own table to have per-button handlers without
+     * a <code>switch</code> over button IDs. Event types without a callback are not observed, so e.g. a click
+     * is reported right after release if no double-click callback is set.
+     *
+     * @see Button::setCallbacks(const ButtonCallbacks *callbacks)
+     */
+    class ButtonCallbacks {
+    public:
+        void set(ButtonEventType type, ButtonCallback callback, void *context = nullptr);
+
+        template<uint8_t Size>
+        void set(ButtonEventType type, InlineCallback<Size> &callback);
+
+        void setOnClick(ButtonCallback callback, void *context = nullptr);
+
+        void setOnDoubleClick(ButtonCallback callback, void *context = nullptr);
+
+        void setOnPress(ButtonCallback callback, void *context = nullptr);
+
+        void setOnRelease(ButtonCallback callback, void *context = nullptr);
+
+        void setOnLongPressStart(ButtonCallback callback, void *context = nullptr);
+
+        void setOnLongPressEnd(ButtonCallback callback, void *context = nullptr);
+
+        void setOnMultiClick(ButtonCallback callback, void *context = nullptr);
+
+        void setOnRepeat(ButtonCallback callback, void *context = nullptr);
+
+        void call(Button &button, ButtonEventType type) const;
+
+        bool observes(ButtonEventType type) const;
+
+    private:
+        /** Number of event types, one callback slot per type */
+        constexpr static uint8_t EVENT_TYPES = static_cast<uint8_t>(ButtonEventType::REPEAT) + 1;
+
+        ButtonCallback m_callbacks[EVENT_TYPES] = {}; /**< Callbacks indexed by event type */
+        void *m_contexts[EVENT_TYPES] = {}; /**< Context pointers passed to callbacks, indexed by event type */
+    };
+
+    /**
+     * @brief Attach an inline callable to an event type.
+     *
+     * The callable is not copied. It has to outlive this object.
+     *
+     * @param type event type.
+     * @param callback callable wrapper holding a lambda.
+     */
+    template<uint8_t Size>
+    void ButtonCallbacks::set(ButtonEventType type, InlineCallback<Size> &callback) {
+        set(type, &InlineCallback<Size>::dispatch, &callback);
+    }
+
+    /**
+     * @brief Call the callback attached to an event type, if there is one.
+     *
+     * Defined in the header, so that the button makes a single indirect call per event.
+     *
+     * @param button is a reference to the instance which produced the event.
+     * @param type event type.
+     */
+    inline void ButtonCallbacks::call(Button &button, ButtonEventType type) const {
+        uint8_t index = static_cast<uint8_t>(type);
+        if (m_callbacks[index] != nullptr)
+            m_callbacks[index](button, m_contexts[index]);
+    }
+
+    /**
+     * @brief Tell the button which event types have a callback.
+     * @param type event type.
+     * @return <code>true</code> if a callback is attached to the event type, <code>false</code> otherwise.
+     */
+    inline bool ButtonCallbacks::observes(ButtonEventType type) const {
+        return m_callbacks[static_cast<uint8_t>(type)] != nullptr;
+    }
+}
+
+#endif // BUTTON_CALLBACKS_H
@@ -0,0 +1,70 @@
+/**
+ *  @file       ButtonEvent.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUTTON_EVENT_H
+#define BUTTON_EVENT_H
+
+#include <inttypes.h>
+
+namespace jsc {
+    /**
+     * @brief Types of events a button can produce.
+     */
+    enum class ButtonEventType : uint8_t {
+        PRESS,
+        RELEASE,
+        CLICK,
+        CLICK_CANCELLED,
+        DOUBLE_CLICK,
+        LONG_PRESS_START,
+        LONG_PRESS_END,
+        MULTI_CLICK, /**< Three or more clicks in a row, see Button::setMaxClickCount() */
+        REPEAT /**< Button is still held, see Button::setRepeatTiming() */
+    };
+
+    /**
+     * @brief Description of a single button event.
+     *
+     * Event carries everything a handler typically needs, so it does not have to call <code>millis()</code>
+     * or query the button again.
+     */
+    struct ButtonEvent {
+        ButtonEventType type; /**< What happened */
+        uint8_t buttonId; /**< ID of the button which produced the event, see Button::getId() */
+        /**
+         * Number of clicks in the gesture: 1 for click, 2 for double-click, 3 or more for multi-click, 0 otherwise.
+         * For repeat events, number of repeats of the press so far, saturating at #MAX_REPEAT_COUNT.
+         */
+        uint8_t clickCount;
+        unsigned long time; /**< Timestamp of the event [milliseconds] */
+
+        /**
+         * Duration of the press which produced the event [milliseconds]. For press, long press start and repeat
+         * events, this is the time the button has been held so far.
+         */
+        unsigned long pressDuration;
+    };
+}
+
+#endif // BUTTON_EVENT_H
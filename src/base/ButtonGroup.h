@@ -0,0 +1,238 @@
+/**
+ *  @file       ButtonGroup.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BUTTON_GROUP_H
+#define BUTTON_GROUP_H
+
+#include "Button.h"
+#include "TickMonitor.h"
+
+namespace jsc {
+    /**
+     * @brief Group of buttons ticked together with a single clock read.
+     *
+     * Calling <code>tick()</code> on each button separately reads the clock once per button.
+     * ButtonGroup reads the clock once per group tick and hands the same timestamp to every member,
+     * so the whole group shares a common timebase. It also configures all of its buttons at once and feeds
+     * a TickMonitor or a ChordDetector.
+     *
+     * It is a convenience, not a faster state machine. Every member is still a full Button ticked on its own,
+     * with its own input read. The group saves one clock read per button, which pays off on boards where
+     * <code>millis()</code> is expensive, e.g. on AVR, where it disables interrupts. On a host, where reading
+     * the clock is a plain load, a group costs as much as ticking the buttons one by one.
+     *
+     * Buttons are not owned by the group. Storage for button references is allocated statically,
+     * no heap is used.
+     *
+     * @tparam N maximum number of buttons the group can hold.
+     */
+    template<uint16_t N>
+    class ButtonGroup {
+    public:
+        bool add(Button &button);
+
+        uint16_t size() const;
+
+        Button &get(uint16_t index);
+
+        void tick();
+
+        void tick(unsigned long now);
+
+        unsigned long nextDeadline();
+
+        unsigned long nextDeadline(unsigned long now);
+
+        void setTickMonitor(TickMonitor *monitor);
+
+        void setEventListener(IButtonEventListener *listener);
+
+        void setCallbacks(const ButtonCallbacks *callbacks);
+
+    private:
+        Button *m_buttons[N]; /**< Buttons ticked by this group, in order of insertion */
+
+        uint16_t m_size = 0; /**< Number of buttons in the group */
+
+        TickMonitor *m_monitor = nullptr; /**< Monitor fed on every tick, if set */
+
+        /** One bit per button, set if the last tick found the button newly pressed */
+        uint8_t m_pressStarted[(N + 7) / 8] = {};
+    };
+
+    /**
+     * @brief Add a button to the group.
+     * @param button a button to be ticked with the group.
+     * @return <code>true</code> if the button was added, <code>false</code> if the group is full.
+     */
+    template<uint16_t N>
+    bool ButtonGroup<N>::add(Button &button) {
+        if (m_size >= N)
+            return false;
+
+        m_buttons[m_size++] = &button;
+        return true;
+    }
+
+    /**
+     * @brief Get number of buttons in the group.
+     * @return number of buttons added so far.
+     */
+    template<uint16_t N>
+    uint16_t ButtonGroup<N>::size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Get a button stored in the group.
+     * @param index position of the button, must be lower than size().
+     * @return a reference to the button.
+     */
+    template<uint16_t N>
+    Button &ButtonGroup<N>::get(uint16_t index) {
+        return *m_buttons[index];
+    }
+
+    /**
+     * @brief Update state machines of all buttons in the group.
+     *
+     * Reads the clock once and ticks every button with the same timestamp.
+     * Call this function periodically in your <code>loop()</code> function instead of ticking
+     * each button separately.
+     */
+    template<uint16_t N>
+    void ButtonGroup<N>::tick() {
+        tick(readClock());
+    }
+
+    /**
+     * @brief Update state machines of all buttons in the group using a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     */
+    template<uint16_t N>
+    void ButtonGroup<N>::tick(unsigned long now) {
+        if (m_monitor == nullptr) {
+            for (uint16_t i = 0; i < m_size; i++)
+                m_buttons[i]->tick(now);
+            return;
+        }
+
+        unsigned long gap = m_monitor->onTick(now);
+        for (uint16_t i = 0; i < m_size; i++) {
+            bool wasPressed = m_buttons[i]->isPressed();
+            m_buttons[i]->tick(now);
+            bool pressed = m_buttons[i]->isPressed();
+
+            uint8_t mask = 1 << (i % 8);
+            // shorter presses are filtered out as bounces by design
+            if ((m_pressStarted[i / 8] & mask) && !pressed && gap > m_buttons[i]->getTiming().debounceTicks)
+                m_monitor->onShortPress();
+
+            if (!wasPressed && pressed)
+                m_pressStarted[i / 8] |= mask;
+            else
+                m_pressStarted[i / 8] &= ~mask;
+        }
+        m_monitor->onDeadline(nextDeadline(now));
+    }
+
+    /**
+     * @brief Tell the user when the group needs to be ticked again.
+     * @return the earliest deadline of all buttons in the group.
+     * @see Button::nextDeadline()
+     */
+    template<uint16_t N>
+    unsigned long ButtonGroup<N>::nextDeadline() {
+        return nextDeadline(readClock());
+    }
+
+    /**
+     * @brief Tell the user when the group needs to be ticked again, relative to a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     * @return the earliest deadline of all buttons in the group, or #NO_DEADLINE if all of them are idle.
+     */
+    template<uint16_t N>
+    unsigned long ButtonGroup<N>::nextDeadline(unsigned long now) {
+        unsigned long deadline = NO_DEADLINE;
+        for (uint16_t i = 0; i < m_size; i++) {
+            unsigned long buttonDeadline = m_buttons[i]->nextDeadline(now);
+            if (buttonDeadline < deadline)
+                deadline = buttonDeadline;
+        }
+        return deadline;
+    }
+
+    /**
+     * @brief Set a monitor detecting ticks coming too rarely.
+     *
+     * On every tick, the group reports the time of the tick, presses seen by this tick only and the tightest
+     * deadline of its buttons to the monitor. Computing the deadline costs a pass over all buttons, so leave
+     * the monitor unset in production builds which do not need it.
+     *
+     * @param monitor object collecting tick statistics, or <code>nullptr</code> to stop monitoring.
+     *
+     * @see TickMonitor
+     */
+    template<uint16_t N>
+    void ButtonGroup<N>::setTickMonitor(TickMonitor *monitor) {
+        m_monitor = monitor;
+        for (uint16_t i = 0; i < (N + 7) / 8; i++)
+            m_pressStarted[i] = 0;
+    }
+
+    /**
+     * @brief Set the same event listener to all buttons in the group.
+     *
+     * Handy with an EventQueue, which collects events of the whole group. Buttons added later
+     * are not affected.
+     *
+     * @param listener object implementing IButtonEventListener interface.
+     *
+     * @see Button::setEventListener(IButtonEventListener *listener)
+     * @see EventQueue
+     */
+    template<uint16_t N>
+    void ButtonGroup<N>::setEventListener(IButtonEventListener *listener) {
+        for (uint16_t i = 0; i < m_size; i++)
+            m_buttons[i]->setEventListener(listener);
+    }
+
+    /**
+     * @brief Set the same table of callbacks to all buttons in the group.
+     *
+     * Callbacks receive the button which produced the event, so one table serves the whole group.
+     * Buttons added later are not affected.
+     *
+     * @param callbacks table of callbacks.
+     *
+     * @see Button::setCallbacks(const ButtonCallbacks *callbacks)
+     */
+    template<uint16_t N>
+    void ButtonGroup<N>::setCallbacks(const ButtonCallbacks *callbacks) {
+        for (uint16_t i = 0; i < m_size; i++)
+            m_buttons[i]->setCallbacks(callbacks);
+    }
+}
+
+#endif // BUTTON_GROUP_H
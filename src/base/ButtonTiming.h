@@ -0,0 +1,69 @@
+/**
+ *  @file       ButtonTiming.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BUTTON_TIMING_H
+#define BUTTON_TIMING_H
+
+#include <inttypes.h>
+
+namespace jsc {
+    /**
+     * @brief Time constraints used to detect button events.
+     *
+     * A timing profile is shared by reference. Many buttons can use the same profile, and changing the profile
+     * retunes all of them at once. Keep the profile alive for as long as buttons use it.
+     *
+     * Profiles which never change can be stored in flash memory and attached with Button::setTimingP():
+     *
+     * <pre>
+     * const ButtonTiming PANEL_TIMING PROGMEM = {20, 300, 1000};
+     * </pre>
+     *
+     * @see Button::setTiming(const ButtonTiming &timing)
+     */
+    struct ButtonTiming {
+        uint8_t debounceTicks; /**< Time to wait before a button press is assumed safe [milliseconds] */
+        uint16_t clickTicks; /**< Time to detect a click event [milliseconds] */
+        uint16_t longPressTicks; /**< Time to detect a long press event, at most 60000 [milliseconds] */
+    };
+
+    /**
+     * @brief Time constraints of auto-repeat while a button is held.
+     *
+     * The first repeat comes <code>delayTicks</code> after the press. Every following interval is shorter than
+     * the previous one by <code>accelerationTicks</code>, starting at <code>intervalTicks</code>, until it reaches
+     * <code>minIntervalTicks</code>. Like a timing profile, a repeat profile is shared by reference.
+     *
+     * @see Button::setRepeatTiming(const RepeatTiming &timing)
+     */
+    struct RepeatTiming {
+        uint16_t delayTicks; /**< Time from press to the first repeat, zero to use long press interval [milliseconds] */
+        uint16_t intervalTicks; /**< Time between the first and the second repeat [milliseconds] */
+        uint16_t minIntervalTicks; /**< Shortest time between two repeats [milliseconds] */
+        uint16_t accelerationTicks; /**< Shortening of every next interval, zero for a constant rate [milliseconds] */
+    };
+}
+
+#endif // BUTTON_TIMING_H
@@ -0,0 +1,343 @@
+/**
+ *  @file       ChordDetector.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHORD_DETECTOR_H
+#define CHORD_DETECTOR_H
+
+#include "ButtonGroup.h"
+
+namespace jsc {
+    /** Milliseconds within which all buttons of a chord have to be pressed */
+    constexpr static int DEFAULT_CHORD_WINDOW_TICKS_MS = 100;
+
+    /**
+     * @brief Types of events a chord can produce.
+     */
+    enum class ChordEventType : uint8_t {
+        PRESS, /**< All buttons of the chord are held */
+        LONG_PRESS, /**< Chord is held for longer than its long press interval */
+        RELEASE /**< The first button of a pressed chord is released */
+    };
+
+    /**
+     * @brief Function called when a chord produces an event.
+     * @param chord index of the chord, in order in which chords were added.
+     * @param type event type.
+     * @param context pointer passed to ChordDetector::setCallback().
+     */
+    typedef void (*ChordCallback)(uint8_t chord, ChordEventType type, void *context);
+
+    /**
+     * @brief Detector of buttons pressed together, e.g. "A+B" or "A+B held for 3 seconds".
+     *
+     * A chord is a set of buttons of a ButtonGroup, given as a bitmask of their positions in the group. It is pressed
+     * when all its buttons are held and the last of them was pressed at most <code>windowTicks</code> after the first
+     * one. Buttons pressed one by one, slower than that, stay separate presses. The chord is released as soon as
+     * any of its buttons is released, and it can be pressed again only after all of them were released.
+     *
+     * When a chord is pressed, clicks of its buttons are suppressed, so releasing a chord does not produce clicks
+     * of its buttons. Press, release and long press events of the buttons are still sent.
+     *
+     * The detector ticks the group and evaluates chords with the same timestamp. It keeps a bitmask of held
+     * buttons, so every chord costs a few bit operations per tick, regardless of the number of its buttons.
+     * Chords are evaluated independently, so chords sharing buttons can be pressed at the same time.
+     *
+     * @tparam Chords maximum number of chords the detector can hold.
+     *
+     * @see Button::isHeld()
+     * @see Button::suppressClicks()
+     */
+    template<uint8_t Chords>
+    class ChordDetector {
+    public:
+        bool add(uint32_t buttons, uint16_t longPressTicks = 0);
+
+        uint8_t size() const;
+
+        void setWindowTicks(uint16_t ticks);
+
+        void setCallback(ChordCallback callback, void *context = nullptr);
+
+        bool isPressed(uint8_t chord) const;
+
+        template<uint16_t N>
+        void tick(ButtonGroup<N> &group);
+
+        template<uint16_t N>
+        void tick(ButtonGroup<N> &group, unsigned long now);
+
+        uint32_t update(uint32_t held, unsigned long now);
+
+        unsigned long nextDeadline(unsigned long now) const;
+
+        void reset();
+
+    private:
+        /**
+         * @brief States of a single chord.
+         */
+        enum class State : uint8_t {
+            IDLE, /**< None of its buttons is held */
+            GATHERING, /**< Some of its buttons are held, window is running */
+            PRESSED, /**< All buttons are held */
+            LONG_PRESSED, /**< All buttons are held, long press was reported */
+            SPENT /**< Chord was released or missed its window, waits until all buttons are released */
+        };
+
+        /**
+         * @brief Chord definition together with its state.
+         */
+        struct Chord {
+            uint32_t buttons; /**< One bit per button of the chord, by position in the group */
+            uint16_t longPressTicks; /**< Long press interval, zero if long press is not reported [milliseconds] */
+            uint16_t time; /**< Lower 16 bits of the first button press, or of the chord press [milliseconds] */
+            State state;
+        };
+
+        void notify(uint8_t chord, ChordEventType type);
+
+        Chord m_chords[Chords]; /**< Chords in order of addition */
+        uint8_t m_size = 0; /**< Number of chords added */
+        uint16_t m_windowTicks = DEFAULT_CHORD_WINDOW_TICKS_MS; /**< Simultaneity window [milliseconds] */
+        ChordCallback m_callback = nullptr; /**< Called on every chord event */
+        void *m_context = nullptr; /**< Context pointer passed to the callback */
+    };
+
+    /**
+     * @brief Add a chord.
+     *
+     * Bit <code>i</code> of <code>buttons</code> stands for the button at position <code>i</code> in the group,
+     * so only the first 32 buttons of a group can be part of a chord.
+     *
+     * @param buttons bitmask of at least two buttons, e.g. <code>(1UL << 0) | (1UL << 2)</code>.
+     * @param longPressTicks time after which a held chord is reported as long pressed, zero to report no long
+     * press [milliseconds].
+     * @return <code>true</code> if the chord was added, <code>false</code> if the detector is full or the chord
+     * has less than two buttons.
+     */
+    template<uint8_t Chords>
+    bool ChordDetector<Chords>::add(uint32_t buttons, uint16_t longPressTicks) {
+        if (m_size >= Chords || (buttons & (buttons - 1)) == 0)
+            return false;
+
+        Chord &chord = m_chords[m_size++];
+        chord.buttons = buttons;
+        chord.longPressTicks = longPressTicks;
+        chord.time = 0;
+        chord.state = State::IDLE;
+        return true;
+    }
+
+    /**
+     * @brief Get number of chords in the detector.
+     * @return number of chords added so far.
+     */
+    template<uint8_t Chords>
+    uint8_t ChordDetector<Chords>::size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Set the simultaneity window.
+     *
+     * Default value is defined in #DEFAULT_CHORD_WINDOW_TICKS_MS. Buttons are held only after their debounce
+     * interval, so the window is measured between debounced presses.
+     *
+     * @param ticks longest time between the first and the last button press of a chord [milliseconds].
+     */
+    template<uint8_t Chords>
+    void ChordDetector<Chords>::setWindowTicks(uint16_t ticks) {
+        m_windowTicks = ticks;
+    }
+
+    /**
+     * @brief Set a function receiving chord events.
+     * @param callback function to be called on every chord event, or <code>nullptr</code> to stop reporting.
+     * @param context arbitrary pointer passed to the callback. This parameter is optional.
+     */
+    template<uint8_t Chords>
+    void ChordDetector<Chords>::setCallback(ChordCallback callback, void *context) {
+        m_callback = callback;
+        m_context = context;
+    }
+
+    /**
+     * @brief Tell the user if a chord is pressed at a given moment.
+     * @param chord index of the chord, lower than size().
+     * @return <code>true</code> if the chord is pressed, <code>false</code> otherwise.
+     */
+    template<uint8_t Chords>
+    bool ChordDetector<Chords>::isPressed(uint8_t chord) const {
+        return m_chords[chord].state == State::PRESSED || m_chords[chord].state == State::LONG_PRESSED;
+    }
+
+    /**
+     * @brief Tick a group of buttons and update chords.
+     *
+     * Call this function periodically in your <code>loop()</code> function instead of ticking the group.
+     *
+     * @param group buttons the chords are made of.
+     */
+    template<uint8_t Chords>
+    template<uint16_t N>
+    void ChordDetector<Chords>::tick(ButtonGroup<N> &group) {
+        tick(group, readClock());
+    }
+
+    /**
+     * @brief Tick a group of buttons and update chords using a timestamp provided by the caller.
+     * @param group buttons the chords are made of.
+     * @param now current time as returned by readClock().
+     */
+    template<uint8_t Chords>
+    template<uint16_t N>
+    void ChordDetector<Chords>::tick(ButtonGroup<N> &group, unsigned long now) {
+        group.tick(now);
+
+        uint16_t count = group.size() < 32 ? group.size() : 32;
+        uint32_t held = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            if (group.get(i).isHeld())
+                held |= static_cast<uint32_t>(1) << i;
+        }
+
+        uint32_t pressed = update(held, now);
+        for (uint16_t i = 0; pressed != 0; i++, pressed >>= 1) {
+            if (pressed & 1)
+                group.get(i).suppressClicks();
+        }
+    }
+
+    /**
+     * @brief Update chords from a bitmask of held buttons.
+     *
+     * Called by <code>tick()</code>, call it yourself only if you track held buttons on your own.
+     * Clicks of buttons in the returned bitmask have to be suppressed then.
+     *
+     * @param held one bit per held button, by position in the group.
+     * @param now current time as returned by readClock().
+     * @return bitmask of buttons of chords pressed by this update.
+     */
+    template<uint8_t Chords>
+    uint32_t ChordDetector<Chords>::update(uint32_t held, unsigned long now) {
+        uint32_t pressed = 0;
+
+        for (uint8_t i = 0; i < m_size; i++) {
+            Chord &chord = m_chords[i];
+            uint32_t chordHeld = held & chord.buttons;
+            uint16_t elapsed = static_cast<uint16_t>(static_cast<uint16_t>(now) - chord.time);
+
+            switch (chord.state) {
+                case State::IDLE:
+                    if (chordHeld == 0)
+                        break;
+
+                    // window starts with the first button, the others may be pressed by the same tick
+                    chord.time = now;
+                    elapsed = 0;
+                    chord.state = State::GATHERING;
+                    // fall through
+                case State::GATHERING:
+                    if (chordHeld == 0) {
+                        chord.state = State::IDLE;
+                    } else if (elapsed > m_windowTicks) {
+                        chord.state = State::SPENT;
+                    } else if (chordHeld == chord.buttons) {
+                        chord.time = now;
+                        chord.state = State::PRESSED;
+                        pressed |= chord.buttons;
+                        notify(i, ChordEventType::PRESS);
+                    }
+                    break;
+                case State::PRESSED:
+                case State::LONG_PRESSED:
+                    if (chordHeld != chord.buttons) {
+                        chord.state = chordHeld == 0 ? State::IDLE : State::SPENT;
+                        notify(i, ChordEventType::RELEASE);
+                    } else if (chord.state == State::PRESSED && chord.longPressTicks != 0
+                               && elapsed > chord.longPressTicks) {
+                        chord.state = State::LONG_PRESSED;
+                        notify(i, ChordEventType::LONG_PRESS);
+                    }
+                    break;
+                case State::SPENT:
+                    if (chordHeld == 0)
+                        chord.state = State::IDLE;
+                    break;
+            }
+        }
+
+        return pressed;
+    }
+
+    /**
+     * @brief Tell the user when chords need to be updated again.
+     *
+     * Chords do not need a tick to close the simultaneity window, only to report a long press. Take the earlier
+     * of this deadline and the deadline of the group.
+     *
+     * @param now current time as returned by readClock().
+     * @return milliseconds until the next long press is due, zero if one is already due, or #NO_DEADLINE.
+     *
+     * @see ButtonGroup::nextDeadline(unsigned long now)
+     */
+    template<uint8_t Chords>
+    unsigned long ChordDetector<Chords>::nextDeadline(unsigned long now) const {
+        unsigned long deadline = NO_DEADLINE;
+
+        for (uint8_t i = 0; i < m_size; i++) {
+            const Chord &chord = m_chords[i];
+            if (chord.state != State::PRESSED || chord.longPressTicks == 0)
+                continue;
+
+            uint16_t elapsed = static_cast<uint16_t>(static_cast<uint16_t>(now) - chord.time);
+            unsigned long chordDeadline = elapsed > chord.longPressTicks ? 0 : chord.longPressTicks + 1 - elapsed;
+            if (chordDeadline < deadline)
+                deadline = chordDeadline;
+        }
+        return deadline;
+    }
+
+    /**
+     * @brief Forget state of all chords. Chords stay added.
+     */
+    template<uint8_t Chords>
+    void ChordDetector<Chords>::reset() {
+        for (uint8_t i = 0; i < m_size; i++)
+            m_chords[i].state = State::IDLE;
+    }
+
+    /**
+     * @brief Pass a chord event to the callback.
+     * @param chord index of the chord.
+     * @param type event type.
+     */
+    template<uint8_t Chords>
+    void ChordDetector<Chords>::notify(uint8_t chord, ChordEventType type) {
+        if (m_callback != nullptr)
+            m_callback(chord, type, m_context);
+    }
+}
+
+#endif // CHORD_DETECTOR_H
@@ -0,0 +1,90 @@
+/**
+ *  @file       Clock.cpp
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Arduino.h>
+#include "Clock.h"
+
+/*
+ * Clock read by all buttons and containers, millis() if not set. Mask keeps the bits the clock counts with.
+ */
+static jsc::ClockSource clockSource = nullptr;
+static unsigned long clockMask = ~0UL;
+
+/**
+ * @brief Set the clock read by all buttons and containers.
+ *
+ * By default, the library reads <code>millis()</code>. Once another clock is set, <code>tick()</code>,
+ * <code>nextDeadline()</code> and <code>capture()</code> variants without a timestamp read it instead,
+ * and all intervals, i.e. ButtonTiming, deadlines, event times and press durations, are counted in its ticks.
+ *
+ * Button keeps 16-bit timestamps, so every interval has to be shorter than 65536 ticks. With <code>micros()</code>,
+ * debounce can be as short as a few microseconds, which suits fast optical sensors, but a click has to be detected
+ * within 65 ms. A prescaled clock, e.g. <code>micros() / 100</code>, gives 0.1 ms resolution with intervals
+ * up to 6.5 seconds.
+ *
+ * Counters narrower than <code>unsigned long</code> are supported down to 16 bits, e.g. a 16-bit hardware timer.
+ * The clock is read by EdgeCapture in interrupt context, so it has to be safe to call there.
+ *
+ * @param source function returning current time, or <code>nullptr</code> to go back to <code>millis()</code>.
+ * @param width number of bits the clock counts with before it wraps to zero, 16 at least.
+ * Defaults to the width of <code>unsigned long</code>.
+ */
+void jsc::setClock(ClockSource source, uint8_t width) {
+    clockSource = source;
+    clockMask = width < 8 * sizeof(unsigned long) ? (1UL << width) - 1 : ~0UL;
+}
+
+/**
+ * @brief Read the clock set by setClock().
+ * @return current time [clock ticks].
+ */
+unsigned long jsc::readClock() {
+    return clockSource != nullptr ? clockSource() : millis();
+}
+
+/**
+ * @brief Compute time elapsed between two readings of the clock.
+ *
+ * Result is correct across the overflow of the clock, whatever its width is.
+ *
+ * @param since earlier reading of the clock.
+ * @param now later reading of the clock.
+ * @return ticks elapsed between the readings.
+ */
+unsigned long jsc::clockElapsed(unsigned long since, unsigned long now) {
+    return (now - since) & clockMask;
+}
+
+/**
+ * @brief Tell if a reading of the clock precedes another one.
+ *
+ * Readings are compared across the overflow of the clock, as long as they are less than half of its range apart.
+ *
+ * @param time reading of the clock.
+ * @param reference reading of the clock to compare with.
+ * @return <code>true</code> if <code>time</code> is earlier than <code>reference</code>.
+ */
+bool jsc::clockBefore(unsigned long time, unsigned long reference) {
+    return clockElapsed(reference, time) > (clockMask >> 1);
+}
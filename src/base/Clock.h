@@ -0,0 +1,48 @@
+/**
+ *  @file       Clock.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <inttypes.h>
+
+namespace jsc {
+    /**
+     * @brief Function returning current time of a free-running counter.
+     *
+     * <code>millis()</code> and <code>micros()</code> have this signature, so does a function reading
+     * a hardware timer, an RTOS tick count or a simulated clock in host tests.
+     */
+    typedef unsigned long (*ClockSource)();
+
+    void setClock(ClockSource source, uint8_t width = 8 * sizeof(unsigned long));
+
+    unsigned long readClock();
+
+    unsigned long clockElapsed(unsigned long since, unsigned long now);
+
+    bool clockBefore(unsigned long time, unsigned long reference);
+}
+
+#endif // CLOCK_H
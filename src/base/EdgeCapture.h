@@ -0,0 +1,229 @@
+/**
+ *  @file       EdgeCapture.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EDGE_CAPTURE_H
+#define EDGE_CAPTURE_H
+
+#include "Button.h"
+
+namespace jsc {
+    /**
+     * @brief Input edge captured in an interrupt.
+     */
+    struct ButtonEdge {
+        unsigned long time; /**< Timestamp of the edge [milliseconds] */
+        uint8_t source; /**< Index of the button as returned by EdgeCapture::add() */
+        bool pressed; /**< <code>true</code> if the button was pressed by this edge, <code>false</code> if released */
+    };
+
+    /**
+     * @brief Interrupt-driven edge capture for buttons.
+     *
+     * Calling <code>tick()</code> from an interrupt runs listeners in interrupt context and races with
+     * <code>tick()</code> called from <code>loop()</code>. EdgeCapture splits the work instead. A pin change
+     * interrupt only calls <code>capture()</code>, which stores a timestamped edge into a lock-free ring buffer.
+     * <code>tick()</code>, called from <code>loop()</code>, drains the buffer and feeds exact edge times into
+     * the buttons' state machines. A press shorter than a loop iteration is therefore never lost.
+     *
+     * The ring buffer has a single producer (interrupts) and a single consumer (<code>loop()</code>).
+     * Producer owns the head index, consumer owns the tail index, both are single bytes, so no locking is needed.
+     * If the buffer is full, the new edge is dropped and counted.
+     *
+     * @tparam Capacity number of edges the buffer can hold, a power of two not greater than 128.
+     * @tparam N maximum number of buttons fed by this capture.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    class EdgeCapture {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(Capacity <= 128, "Capacity must not exceed 128 edges");
+
+    public:
+        int16_t add(Button &button);
+
+        void capture(uint8_t source, bool pressed);
+
+        void capture(uint8_t source, bool pressed, unsigned long time);
+
+        uint8_t getPendingCount() const;
+
+        uint16_t getOverflowCount() const;
+
+        void tick();
+
+        void tick(unsigned long now);
+
+    private:
+        ButtonEdge m_edges[Capacity]; /**< Ring buffer storage */
+        volatile uint8_t m_head = 0; /**< Free-running write index, modified by producer only */
+        volatile uint8_t m_tail = 0; /**< Free-running read index, modified by consumer only */
+        volatile uint16_t m_overflows = 0; /**< Number of edges dropped because the buffer was full */
+
+        Button *m_buttons[N]; /**< Buttons indexed by their source */
+        bool m_pressed[N]; /**< Last known input level of each button */
+        uint8_t m_size = 0; /**< Number of buttons added */
+
+        unsigned long m_lastTime = 0; /**< Timestamp of the last state machine update, keeps time monotonic */
+        bool m_lastTimeValid = false; /**< Set after the first state machine update, time is kept monotonic since */
+    };
+
+    /**
+     * Prevent compiler from moving memory accesses across this point. Ring buffer slot must be written
+     * (or read) before the index publishing it is updated.
+     */
+    inline void edgeCaptureBarrier() {
+        __asm__ __volatile__("" ::: "memory");
+    }
+
+    /**
+     * @brief Add a button fed by captured edges.
+     *
+     * Once added, the button should not be ticked on its own. EdgeCapture takes care of it.
+     *
+     * @param button a button whose edges will be captured.
+     * @return source index to pass to <code>capture()</code>, or -1 if no more buttons can be added.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    int16_t EdgeCapture<Capacity, N>::add(Button &button) {
+        if (m_size >= N)
+            return -1;
+
+        m_buttons[m_size] = &button;
+        m_pressed[m_size] = false;
+        return m_size++;
+    }
+
+    /**
+     * @brief Capture an edge. Call this function from your interrupt handler.
+     *
+     * Edge is timestamped with readClock(). The default clock, <code>millis()</code>, is safe to call in an interrupt.
+     *
+     * @param source button index as returned by <code>add()</code>.
+     * @param pressed <code>true</code> if the button is pressed after the edge, <code>false</code> otherwise.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    void EdgeCapture<Capacity, N>::capture(uint8_t source, bool pressed) {
+        capture(source, pressed, readClock());
+    }
+
+    /**
+     * @brief Capture an edge with a timestamp provided by the caller.
+     *
+     * @param source button index as returned by <code>add()</code>.
+     * @param pressed <code>true</code> if the button is pressed after the edge, <code>false</code> otherwise.
+     * @param time timestamp of the edge [milliseconds].
+     */
+    template<uint8_t Capacity, uint8_t N>
+    void EdgeCapture<Capacity, N>::capture(uint8_t source, bool pressed, unsigned long time) {
+        uint8_t head = m_head;
+        if (static_cast<uint8_t>(head - m_tail) >= Capacity) {
+            m_overflows = m_overflows + 1;
+            return;
+        }
+
+        ButtonEdge &edge = m_edges[head & (Capacity - 1)];
+        edge.time = time;
+        edge.source = source;
+        edge.pressed = pressed;
+
+        edgeCaptureBarrier();
+        m_head = head + 1;
+    }
+
+    /**
+     * @brief Get number of edges waiting to be processed.
+     * @return number of edges in the buffer.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    uint8_t EdgeCapture<Capacity, N>::getPendingCount() const {
+        return static_cast<uint8_t>(m_head - m_tail);
+    }
+
+    /**
+     * @brief Get number of edges dropped because the buffer was full.
+     *
+     * Dropped edges mean that <code>tick()</code> is called too rarely or the buffer is too small.
+     *
+     * @return number of dropped edges.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    uint16_t EdgeCapture<Capacity, N>::getOverflowCount() const {
+        // counter is modified in an interrupt, read it until two reads agree to avoid a torn value
+        uint16_t overflows;
+        do {
+            overflows = m_overflows;
+        } while (overflows != m_overflows);
+        return overflows;
+    }
+
+    /**
+     * @brief Process captured edges and update state machines of all buttons.
+     *
+     * Call this function periodically in your <code>loop()</code> function, never from an interrupt.
+     */
+    template<uint8_t Capacity, uint8_t N>
+    void EdgeCapture<Capacity, N>::tick() {
+        tick(readClock());
+    }
+
+    /**
+     * @brief Process captured edges and update all buttons using a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     */
+    template<uint8_t Capacity, uint8_t N>
+    void EdgeCapture<Capacity, N>::tick(unsigned long now) {
+        uint8_t head = m_head;
+        edgeCaptureBarrier();
+
+        for (uint8_t tail = m_tail; tail != head; tail++) {
+            ButtonEdge edge = m_edges[tail & (Capacity - 1)];
+            edgeCaptureBarrier();
+            m_tail = tail + 1;
+
+            if (edge.source >= m_size)
+                continue;
+
+            // an edge captured while the previous tick was running may be older than that tick
+            if (m_lastTimeValid && clockBefore(edge.time, m_lastTime))
+                edge.time = m_lastTime;
+            m_lastTime = edge.time;
+            m_lastTimeValid = true;
+
+            // let timeouts which elapsed before the edge fire first, then apply the edge itself
+            Button *button = m_buttons[edge.source];
+            button->tick(edge.time, m_pressed[edge.source]);
+            m_pressed[edge.source] = edge.pressed;
+            button->tick(edge.time, edge.pressed);
+        }
+
+        if (m_lastTimeValid && clockBefore(now, m_lastTime))
+            now = m_lastTime;
+        m_lastTime = now;
+        m_lastTimeValid = true;
+
+        for (uint8_t i = 0; i < m_size; i++)
+            m_buttons[i]->tick(now, m_pressed[i]);
+    }
+}
+
+#endif // EDGE_CAPTURE_H
@@ -0,0 +1,172 @@
+/**
+ *  @file       EventQueue.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include "../interfaces/IButtonEventListener.h"
+
+namespace jsc {
+    /**
+     * @brief Fixed-capacity queue of button events, drained by the application.
+     *
+     * Listeners are called from inside <code>tick()</code>, so a slow handler delays detection on every button
+     * ticked after it. Set an EventQueue as the event listener of one or more buttons instead. <code>tick()</code>
+     * then only stores a ButtonEvent, and the application drains the events with <code>pollEvent()</code>
+     * whenever it is convenient, e.g. all of them at the end of <code>loop()</code>. Events of different buttons
+     * are told apart by ButtonEvent::buttonId.
+     *
+     * If the queue is full, the new event is dropped and counted. By default, all event types are queued, so a click
+     * is queued only after the double-click interval elapses. Stop observing double-clicks with
+     * <code>setObserved()</code> to get clicks right after release.
+     *
+     * @tparam Capacity number of events the queue can hold, a power of two not greater than 128.
+     *
+     * @see ButtonGroup::setEventListener(IButtonEventListener *listener)
+     */
+    template<uint8_t Capacity>
+    class EventQueue : public IButtonEventListener {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+        static_assert(Capacity <= 128, "Capacity must not exceed 128 events");
+
+    public:
+        bool pollEvent(ButtonEvent &event);
+
+        uint8_t getPendingCount() const;
+
+        uint16_t getOverflowCount() const;
+
+        void setObserved(ButtonEventType type, bool observed);
+
+        void clear();
+
+        void onEvent(Button &button, const ButtonEvent &event) override;
+
+        bool observes(ButtonEventType type) override;
+
+    private:
+        ButtonEvent m_events[Capacity]; /**< Ring buffer storage */
+        uint8_t m_head = 0; /**< Free-running write index */
+        uint8_t m_tail = 0; /**< Free-running read index */
+        uint16_t m_overflows = 0; /**< Number of events dropped because the queue was full, saturates at 65535 */
+        uint16_t m_observed = 0xFFFF; /**< One bit per event type, set if events of the type are queued */
+    };
+
+    /**
+     * @brief Take the oldest event out of the queue.
+     * @param event receives the event, left untouched if the queue is empty.
+     * @return <code>true</code> if an event was taken, <code>false</code> if the queue is empty.
+     */
+    template<uint8_t Capacity>
+    bool EventQueue<Capacity>::pollEvent(ButtonEvent &event) {
+        if (m_tail == m_head)
+            return false;
+
+        event = m_events[m_tail & (Capacity - 1)];
+        m_tail++;
+        return true;
+    }
+
+    /**
+     * @brief Get number of events waiting in the queue.
+     * @return number of events.
+     */
+    template<uint8_t Capacity>
+    uint8_t EventQueue<Capacity>::getPendingCount() const {
+        return static_cast<uint8_t>(m_head - m_tail);
+    }
+
+    /**
+     * @brief Get number of events dropped because the queue was full.
+     *
+     * Dropped events mean that the queue is drained too rarely or it is too small.
+     *
+     * @return number of dropped events, saturates at 65535.
+     */
+    template<uint8_t Capacity>
+    uint16_t EventQueue<Capacity>::getOverflowCount() const {
+        return m_overflows;
+    }
+
+    /**
+     * @brief Decide whether events of a type are queued.
+     *
+     * Buttons ask their listener which events it observes, e.g. a click is reported right after release
+     * if double-clicks are not observed.
+     *
+     * @param type event type.
+     * @param observed <code>true</code> to queue events of the type, <code>false</code> to ignore them.
+     */
+    template<uint8_t Capacity>
+    void EventQueue<Capacity>::setObserved(ButtonEventType type, bool observed) {
+        uint16_t mask = 1 << static_cast<uint8_t>(type);
+        if (observed)
+            m_observed |= mask;
+        else
+            m_observed &= ~mask;
+    }
+
+    /**
+     * @brief Drop all waiting events and reset the overflow counter.
+     */
+    template<uint8_t Capacity>
+    void EventQueue<Capacity>::clear() {
+        m_tail = m_head;
+        m_overflows = 0;
+    }
+
+    /**
+     * @brief Store an event. Called by buttons from <code>tick()</code>.
+     * @param button button which produced the event.
+     * @param event the event.
+     */
+    template<uint8_t Capacity>
+    void EventQueue<Capacity>::onEvent(Button &/*button*/, const ButtonEvent &event) {
+        if (!observes(event.type))
+            return;
+
+        if (static_cast<uint8_t>(m_head - m_tail) >= Capacity) {
+            if (m_overflows < 0xFFFF)
+                m_overflows++;
+            return;
+        }
+
+        m_events[m_head & (Capacity - 1)] = event;
+        m_head++;
+    }
+
+    /**
+     * @brief Tell the button whether events of a type are queued.
+     * @param type event type.
+     * @return <code>true</code> if events of the type are queued.
+     *
+     * @see setObserved(ButtonEventType type, bool observed)
+     */
+    template<uint8_t Capacity>
+    bool EventQueue<Capacity>::observes(ButtonEventType type) {
+        return m_observed & (1 << static_cast<uint8_t>(type));
+    }
+}
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,338 @@
+/**
+ *  @file       GestureRecognizer.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GESTURE_RECOGNIZER_H
+#define GESTURE_RECOGNIZER_H
+
+#include "../interfaces/IButtonEventListener.h"
+
+namespace jsc {
+    /** Milliseconds which may pass between two presses of a gesture */
+    constexpr static int DEFAULT_GESTURE_TIMEOUT_TICKS_MS = 1000;
+
+    /** Highest total number of steps of all gestures in a GestureRecognizer */
+    constexpr static uint8_t MAX_GESTURE_STEPS = 32;
+
+    /**
+     * @brief Kinds of presses a gesture step matches.
+     */
+    enum class GestureToken : uint8_t {
+        SHORT, /**< Press released before the long press interval */
+        LONG, /**< Press held for longer than the long press interval */
+        PRESS /**< Any press, short or long */
+    };
+
+    /**
+     * @brief Single step of a gesture: a press of a button.
+     */
+    struct GestureStep {
+        uint8_t buttonId; /**< ID of the button, see Button::getId() */
+        GestureToken token; /**< Kind of the press */
+    };
+
+    /**
+     * @brief Function called when a gesture is recognized.
+     * @param gesture index of the gesture, in order in which gestures were added.
+     * @param context pointer passed to GestureRecognizer::setCallback().
+     */
+    typedef void (*GestureCallback)(uint8_t gesture, void *context);
+
+    /**
+     * @brief Get number of slots of the button index of a GestureRecognizer.
+     * @param buttons maximum number of distinct buttons.
+     * @param slots candidate number of slots, used by the recursion.
+     * @return the lowest power of two at least twice the number of buttons.
+     */
+    constexpr static uint16_t gestureIndexSlots(uint16_t buttons, uint16_t slots = 1) {
+        return slots >= 2 * buttons ? slots : gestureIndexSlots(buttons, 2 * slots);
+    }
+
+    /**
+     * @brief Recognizer of press sequences, e.g. "long, short, short" on one button or "A, B, A" across buttons.
+     *
+     * Set the recognizer as the event listener of the buttons the gestures are made of. Every press of these
+     * buttons becomes a token: a short press when the button is released as a click, a long press as soon as
+     * it is detected. Double-clicks are not observed, so clicks are reported right after release and every press
+     * is a token of its own. If another listener of a button makes it wait for double-clicks anyway, e.g. a legacy
+     * IOnDoubleClickListener, merged double-clicks and multi-clicks are fed to the automaton as separate short
+     * presses, all timed at the last release.
+     *
+     * Gestures are compiled into a bit-parallel automaton: every step of every gesture is one bit of a 32-bit state,
+     * and every button has two masks telling which steps its short and long press match. Masks are found through
+     * an index hashed by button ID, which is at most half full, so an event costs a probe or two, then a shift,
+     * an OR and an AND of the state, no matter how many gestures or buttons there are. RAM cost is nine bytes
+     * per distinct button on AVR, plus two to four bytes of the index, steps take a bit each.
+     *
+     * A gesture is recognized on its last press, as long as no more than <code>timeoutTicks</code> passed between
+     * any two of its presses. Then the callback fires and the automaton starts over. Presses of other buttons
+     * of the recognizer break a gesture in progress. If several gestures end on the same press, the gesture
+     * added first wins, and a gesture which is a prefix of another one hides it.
+     *
+     * @tparam Buttons maximum number of distinct buttons the gestures can use.
+     */
+    template<uint8_t Buttons>
+    class GestureRecognizer : public IButtonEventListener {
+    public:
+        bool add(const GestureStep *steps, uint8_t length);
+
+        uint8_t size() const;
+
+        void setTimeoutTicks(uint16_t ticks);
+
+        void setCallback(GestureCallback callback, void *context = nullptr);
+
+        void reset();
+
+        void onEvent(Button &button, const ButtonEvent &event) override;
+
+        bool observes(ButtonEventType type) override;
+
+    private:
+        /**
+         * @brief Steps matched by presses of a single button.
+         */
+        struct ButtonMasks {
+            uint8_t buttonId; /**< ID of the button */
+            uint32_t shortMask; /**< One bit per step matched by a short press */
+            uint32_t longMask; /**< One bit per step matched by a long press */
+        };
+
+        /** Number of slots of the button index, a power of two */
+        constexpr static uint16_t INDEX_SLOTS = gestureIndexSlots(Buttons);
+
+        int16_t findButton(uint8_t buttonId) const;
+
+        void feed(uint32_t mask, uint16_t time);
+
+        ButtonMasks m_buttons[Buttons]; /**< Masks of buttons used by the gestures */
+        uint8_t m_index[INDEX_SLOTS] = {}; /**< Open-addressed map of button IDs to table index + 1, 0 is empty */
+        uint8_t m_buttonCount = 0; /**< Number of distinct buttons used */
+        uint8_t m_steps = 0; /**< Total number of steps of all gestures, i.e. bits used */
+        uint8_t m_size = 0; /**< Number of gestures */
+        uint32_t m_firstSteps = 0; /**< One bit per first step of a gesture */
+        uint32_t m_lastSteps = 0; /**< One bit per last step of a gesture */
+        uint32_t m_state = 0; /**< One bit per step matched by the latest presses */
+        uint16_t m_lastTime = 0; /**< Lower 16 bits of the previous press timestamp [milliseconds] */
+        uint16_t m_timeoutTicks = DEFAULT_GESTURE_TIMEOUT_TICKS_MS; /**< Longest time between two presses [milliseconds] */
+        GestureCallback m_callback = nullptr; /**< Called when a gesture is recognized */
+        void *m_context = nullptr; /**< Context pointer passed to the callback */
+        bool m_clickFed = false; /**< First click of a merged double-click was fed already as a speculative click */
+    };
+
+    /**
+     * @brief Add a gesture.
+     *
+     * Steps are compiled into the automaton, the array is not referenced afterwards.
+     *
+     * @param steps presses of the gesture, in order.
+     * @param length number of steps.
+     * @return <code>true</code> if the gesture was added, <code>false</code> if it is empty, or steps of all
+     * gestures would exceed #MAX_GESTURE_STEPS, or there is no room for its buttons.
+     */
+    template<uint8_t Buttons>
+    bool GestureRecognizer<Buttons>::add(const GestureStep *steps, uint8_t length) {
+        if (length == 0 || length > MAX_GESTURE_STEPS - m_steps)
+            return false;
+
+        // check room for new buttons first, so that a rejected gesture leaves no trace
+        uint8_t newButtons = 0;
+        for (uint8_t i = 0; i < length; i++) {
+            bool known = findButton(steps[i].buttonId) >= 0;
+            for (uint8_t j = 0; j < i && !known; j++)
+                known = steps[j].buttonId == steps[i].buttonId;
+            if (!known)
+                newButtons++;
+        }
+        if (newButtons > Buttons - m_buttonCount)
+            return false;
+
+        for (uint8_t i = 0; i < length; i++) {
+            int16_t index = findButton(steps[i].buttonId);
+            if (index < 0) {
+                index = m_buttonCount++;
+                m_buttons[index].buttonId = steps[i].buttonId;
+                m_buttons[index].shortMask = 0;
+                m_buttons[index].longMask = 0;
+
+                // index is at most half full, a free slot always follows
+                uint16_t slot = steps[i].buttonId & (INDEX_SLOTS - 1);
+                while (m_index[slot] != 0)
+                    slot = (slot + 1) & (INDEX_SLOTS - 1);
+                m_index[slot] = index + 1;
+            }
+
+            uint32_t bit = static_cast<uint32_t>(1) << (m_steps + i);
+            if (steps[i].token != GestureToken::LONG)
+                m_buttons[index].shortMask |= bit;
+            if (steps[i].token != GestureToken::SHORT)
+                m_buttons[index].longMask |= bit;
+        }
+
+        m_firstSteps |= static_cast<uint32_t>(1) << m_steps;
+        m_steps += length;
+        m_lastSteps |= static_cast<uint32_t>(1) << (m_steps - 1);
+        m_size++;
+        return true;
+    }
+
+    /**
+     * @brief Get number of gestures.
+     * @return number of gestures added so far.
+     */
+    template<uint8_t Buttons>
+    uint8_t GestureRecognizer<Buttons>::size() const {
+        return m_size;
+    }
+
+    /**
+     * @brief Set the longest time between two presses of a gesture.
+     *
+     * Default value is defined in #DEFAULT_GESTURE_TIMEOUT_TICKS_MS. Presses are timed when they become tokens,
+     * i.e. on release of a short press and on detection of a long press.
+     *
+     * @param ticks timeout interval [milliseconds].
+     */
+    template<uint8_t Buttons>
+    void GestureRecognizer<Buttons>::setTimeoutTicks(uint16_t ticks) {
+        m_timeoutTicks = ticks;
+    }
+
+    /**
+     * @brief Set a function called when a gesture is recognized.
+     * @param callback function receiving the gesture index, or <code>nullptr</code> to stop reporting.
+     * @param context arbitrary pointer passed to the callback. This parameter is optional.
+     */
+    template<uint8_t Buttons>
+    void GestureRecognizer<Buttons>::setCallback(GestureCallback callback, void *context) {
+        m_callback = callback;
+        m_context = context;
+    }
+
+    /**
+     * @brief Forget presses seen so far. Gestures stay added.
+     */
+    template<uint8_t Buttons>
+    void GestureRecognizer<Buttons>::reset() {
+        m_state = 0;
+        m_clickFed = false;
+    }
+
+    /**
+     * @brief Feed an event into the automaton. Called by buttons from <code>tick()</code>.
+     *
+     * Double-clicks and multi-clicks only arrive when another listener of the button observes them. Each of their
+     * clicks is fed as a short press, except the first one if it was already reported as a speculative click.
+     *
+     * @param button button which produced the event.
+     * @param event the event.
+     */
+    template<uint8_t Buttons>
+    void GestureRecognizer<Buttons>::onEvent(Button &/*button*/, const ButtonEvent &event) {
+        uint8_t presses = 1;
+        switch (event.type) {
+            case ButtonEventType::CLICK:
+            case ButtonEventType::LONG_PRESS_START:
+                break;
+            case ButtonEventType::CLICK_CANCELLED:
+                m_clickFed = true;
+                return;
+            case ButtonEventType::DOUBLE_CLICK:
+            case ButtonEventType::MULTI_CLICK:
+                presses = m_clickFed ? event.clickCount - 1 : event.clickCount;
+                break;
+            default:
+                return;
+        }
+        m_clickFed = false;
+
+        uint32_t mask = 0;
+        int16_t index = findButton(event.buttonId);
+        if (index >= 0)
+            mask = event.type == ButtonEventType::LONG_PRESS_START ? m_buttons[index].longMask
+                                                                   : m_buttons[index].shortMask;
+
+        uint16_t time = static_cast<uint16_t>(event.time);
+        for (; presses > 0; presses--)
+            feed(mask, time);
+    }
+
+    /**
+     * @brief Tell buttons which events the recognizer consumes.
+     *
+     * Only clicks and long press starts are observed. Double-clicks are not, so that every press is reported
+     * as a click of its own right after release.
+     *
+     * @param type event type.
+     * @return <code>true</code> for click and long press start events.
+     */
+    template<uint8_t Buttons>
+    bool GestureRecognizer<Buttons>::observes(ButtonEventType type) {
+        return type == ButtonEventType::CLICK || type == ButtonEventType::LONG_PRESS_START;
+    }
+
+    /**
+     * @brief Find masks of a button.
+     * @param buttonId ID of the button.
+     * @return index into the button table, or -1 if no gesture uses the button.
+     */
+    template<uint8_t Buttons>
+    int16_t GestureRecognizer<Buttons>::findButton(uint8_t buttonId) const {
+        for (uint16_t slot = buttonId & (INDEX_SLOTS - 1); m_index[slot] != 0; slot = (slot + 1) & (INDEX_SLOTS - 1)) {
+            uint8_t index = m_index[slot] - 1;
+            if (m_buttons[index].buttonId == buttonId)
+                return index;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Advance the automaton by a single press, fire the callback if a gesture is complete.
+     * @param mask steps matched by the press.
+     * @param time lower 16 bits of the press timestamp [milliseconds].
+     */
+    template<uint8_t Buttons>
+    void GestureRecognizer<Buttons>::feed(uint32_t mask, uint16_t time) {
+        if (static_cast<uint16_t>(time - m_lastTime) > m_timeoutTicks)
+            m_state = 0;
+        m_lastTime = time;
+
+        // every matched step advances to the next one, and every gesture may start anew
+        m_state = ((m_state << 1) | m_firstSteps) & mask;
+
+        uint32_t matched = m_state & m_lastSteps;
+        if (matched == 0)
+            return;
+
+        // gesture index is the number of gestures ending below the lowest match
+        uint8_t gesture = 0;
+        for (uint32_t ends = m_lastSteps & ((matched & (~matched + 1)) - 1); ends != 0; ends &= ends - 1)
+            gesture++;
+
+        m_state = 0;
+        if (m_callback != nullptr)
+            m_callback(gesture, m_context);
+    }
+}
+
+#endif // GESTURE_RECOGNIZER_H
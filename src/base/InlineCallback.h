@@ -0,0 +1,129 @@
+/**
+ *  @file       InlineCallback.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INLINE_CALLBACK_H
+#define INLINE_CALLBACK_H
+
+#include <Arduino.h>
+
+namespace jsc {
+    class Button;
+
+    /**
+     * @brief Signature of a function called on a button event.
+     *
+     * @param button is a reference to the instance which produced the event.
+     * @param context arbitrary pointer given when the callback was attached.
+     */
+    typedef void (*ButtonCallback)(Button &button, void *context);
+
+    /**
+     * @brief Fixed-size wrapper for lambdas capturing a few values.
+     *
+     * A lambda with captures cannot be converted to a plain function pointer. InlineCallback stores
+     * the lambda object in its own buffer instead, so no heap is needed. Captures have to be trivially
+     * copyable (references, pointers, numbers) and fit into <code>Size</code> bytes, otherwise compilation fails.
+     *
+     * @code
+     * InlineCallback<> toggle = [&led](Button &button) { led.toggle(); };
+     * callbacks.set(ButtonEventType::CLICK, toggle);
+     * @endcode
+     *
+     * @tparam Size capacity of the buffer holding the lambda, two pointers by default.
+     */
+    template<uint8_t Size = 2 * sizeof(void *)>
+    class InlineCallback {
+    public:
+        InlineCallback();
+
+        template<typename F>
+        InlineCallback(const F &function);
+
+        InlineCallback(const InlineCallback &other) = default;
+
+        /* Keep copies of non-const instances away from the lambda constructor */
+        InlineCallback(InlineCallback &other) = default;
+
+        void operator()(Button &button);
+
+        static void dispatch(Button &button, void *context);
+
+    private:
+        template<typename F>
+        static void invoke(void *storage, Button &button);
+
+        alignas(void *) unsigned char m_storage[Size]; /**< Copy of the lambda object */
+        void (*m_invoker)(void *storage, Button &button); /**< Calls the lambda stored in the buffer */
+    };
+
+    /**
+     * @brief Constructor for an empty callback, which does nothing when called.
+     */
+    template<uint8_t Size>
+    InlineCallback<Size>::InlineCallback() : m_invoker(nullptr) {}
+
+    /**
+     * @brief Constructor storing a copy of a lambda.
+     * @param function a lambda taking a reference to Button.
+     */
+    template<uint8_t Size>
+    template<typename F>
+    InlineCallback<Size>::InlineCallback(const F &function) : m_invoker(&invoke<F>) {
+        static_assert(sizeof(F) <= Size, "Lambda captures do not fit into InlineCallback, increase its Size");
+        static_assert(alignof(F) <= alignof(void *), "Lambda captures are over-aligned for InlineCallback");
+        static_assert(__is_trivially_copyable(F), "Lambda captures must be trivially copyable");
+        memcpy(m_storage, &function, sizeof(F));
+    }
+
+    /**
+     * @brief Call the stored lambda.
+     * @param button is a reference to the instance which produced the event.
+     */
+    template<uint8_t Size>
+    void InlineCallback<Size>::operator()(Button &button) {
+        if (m_invoker != nullptr)
+            m_invoker(m_storage, button);
+    }
+
+    /**
+     * @brief Adapter to ButtonCallback signature.
+     * @param button is a reference to the instance which produced the event.
+     * @param context pointer to the InlineCallback instance.
+     */
+    template<uint8_t Size>
+    void InlineCallback<Size>::dispatch(Button &button, void *context) {
+        (*static_cast<InlineCallback<Size> *>(context))(button);
+    }
+
+    /**
+     * @brief Call a lambda of a known type stored in a buffer.
+     */
+    template<uint8_t Size>
+    template<typename F>
+    void InlineCallback<Size>::invoke(void *storage, Button &button) {
+        (*static_cast<F *>(storage))(button);
+    }
+}
+
+#endif // INLINE_CALLBACK_H
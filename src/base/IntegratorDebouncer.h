@@ -0,0 +1,109 @@
+/**
+ *  @file       IntegratorDebouncer.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef INTEGRATOR_DEBOUNCER_H
+#define INTEGRATOR_DEBOUNCER_H
+
+#include <inttypes.h>
+#include "../interfaces/IDebouncer.h"
+
+namespace jsc {
+    /**
+     * @brief Debouncer integrating consistent samples in a saturating counter.
+     *
+     * Each pressed sample increments the counter, each released sample decrements it. Debounced level becomes
+     * pressed when the counter reaches <code>Samples</code> and released when it drops to zero. A single glitch
+     * only moves the counter by one, so it neither resets a press in progress nor produces a release.
+     *
+     * - Latency: <code>Samples</code> ticks after a clean edge, more if the input bounces.
+     * - RAM: 1 byte, plus a vtable pointer.
+     * - CPU: one comparison and one increment or decrement per tick.
+     *
+     * Latency is counted in samples, not in milliseconds, so it depends on how often the button is ticked.
+     *
+     * @tparam Samples number of consistent samples needed to change the debounced level, 1 - 127.
+     */
+    template<uint8_t Samples>
+    class IntegratorDebouncer : public IDebouncer {
+        static_assert(Samples >= 1 && Samples <= 127, "Integrator needs 1 - 127 samples");
+
+    public:
+        IntegratorDebouncer();
+
+        bool update(bool pressed, unsigned long now) override;
+
+        bool isSettled() override;
+
+        void reset() override;
+
+    private:
+        uint8_t m_integrator : 7; /**< Saturating counter of pressed samples, 0 - Samples */
+        bool m_pressed : 1; /**< Debounced level */
+    };
+
+    /**
+     * @brief Constructor for the class.
+     */
+    template<uint8_t Samples>
+    IntegratorDebouncer<Samples>::IntegratorDebouncer() : m_integrator(0), m_pressed(false) {}
+
+    /**
+     * @brief Filter a raw input sample.
+     * @param pressed <code>true</code> if the raw input reads as pressed.
+     * @param now timestamp of the sample, not used.
+     * @return debounced input level.
+     */
+    template<uint8_t Samples>
+    bool IntegratorDebouncer<Samples>::update(bool pressed, unsigned long /*now*/) {
+        if (pressed) {
+            if (m_integrator < Samples && ++m_integrator == Samples)
+                m_pressed = true;
+        } else {
+            if (m_integrator > 0 && --m_integrator == 0)
+                m_pressed = false;
+        }
+        return m_pressed;
+    }
+
+    /**
+     * @brief Tell whether the counter is saturated in either direction.
+     * @return <code>true</code> if no decision is pending.
+     */
+    template<uint8_t Samples>
+    bool IntegratorDebouncer<Samples>::isSettled() {
+        return m_integrator == (m_pressed ? Samples : 0);
+    }
+
+    /**
+     * @brief Forget all samples.
+     */
+    template<uint8_t Samples>
+    void IntegratorDebouncer<Samples>::reset() {
+        m_integrator = 0;
+        m_pressed = false;
+    }
+}
+
+#endif // INTEGRATOR_DEBOUNCER_H
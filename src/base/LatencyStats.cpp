@@ -0,0 +1,163 @@
+/**
+ *  @file       LatencyStats.cpp
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyStats.h"
+using namespace jsc;
+
+/** Saturation value of counters */
+constexpr static uint16_t MAX_COUNT = 0xFFFF;
+
+/**
+ * @brief Find a histogram bucket for a latency.
+ * @param latency latency [milliseconds].
+ * @return bucket index, latencies of 512 ms and above fall into the last bucket.
+ */
+static uint8_t bucketOf(uint16_t latency) {
+    uint8_t bucket = 0;
+    for (uint16_t value = latency >> 3; value != 0 && bucket < LatencyStats::HISTOGRAM_BUCKETS - 1; value >>= 1)
+        bucket++;
+    return bucket;
+}
+
+/**
+ * @brief Record a dispatched event.
+ *
+ * Called by buttons, you do not need to call it yourself.
+ *
+ * @param type event type.
+ * @param latency time since the first raw edge of the transition which caused the event [milliseconds].
+ * @param tickInterval time between the tick which saw the edge and the tick before it [milliseconds].
+ */
+void LatencyStats::record(ButtonEventType type, uint16_t latency, uint16_t tickInterval) {
+    Entry &entry = m_entries[static_cast<uint8_t>(type)];
+
+    if (entry.count == 0 || latency < entry.minLatency)
+        entry.minLatency = latency;
+    if (latency > entry.maxLatency)
+        entry.maxLatency = latency;
+    if (tickInterval > entry.maxTickInterval)
+        entry.maxTickInterval = tickInterval;
+
+    // sums stop together with the counter, so that the means stay valid
+    if (entry.count < MAX_COUNT) {
+        entry.count++;
+        entry.latencySum += latency;
+        entry.tickIntervalSum += tickInterval;
+    }
+
+    uint16_t &bucket = entry.histogram[bucketOf(latency)];
+    if (bucket < MAX_COUNT)
+        bucket++;
+}
+
+/**
+ * @brief Get number of recorded events of a type.
+ * @param type event type.
+ * @return a number of events, saturates at 65535.
+ */
+uint16_t LatencyStats::getCount(ButtonEventType type) {
+    return m_entries[static_cast<uint8_t>(type)].count;
+}
+
+/**
+ * @brief Get the shortest latency of an event type.
+ * @param type event type.
+ * @return latency in milliseconds, zero if no event was recorded.
+ */
+uint16_t LatencyStats::getMinLatency(ButtonEventType type) {
+    return m_entries[static_cast<uint8_t>(type)].minLatency;
+}
+
+/**
+ * @brief Get the longest latency of an event type.
+ * @param type event type.
+ * @return latency in milliseconds, zero if no event was recorded.
+ */
+uint16_t LatencyStats::getMaxLatency(ButtonEventType type) {
+    return m_entries[static_cast<uint8_t>(type)].maxLatency;
+}
+
+/**
+ * @brief Get the mean latency of an event type.
+ * @param type event type.
+ * @return latency in milliseconds, zero if no event was recorded.
+ */
+uint16_t LatencyStats::getMeanLatency(ButtonEventType type) {
+    const Entry &entry = m_entries[static_cast<uint8_t>(type)];
+    return entry.count == 0 ? 0 : entry.latencySum / entry.count;
+}
+
+/**
+ * @brief Get the longest tick interval at an edge which caused an event of a type.
+ * @param type event type.
+ * @return tick interval in milliseconds, zero if no event was recorded.
+ */
+uint16_t LatencyStats::getMaxTickInterval(ButtonEventType type) {
+    return m_entries[static_cast<uint8_t>(type)].maxTickInterval;
+}
+
+/**
+ * @brief Get the mean tick interval at an edge which caused an event of a type.
+ * @param type event type.
+ * @return tick interval in milliseconds, zero if no event was recorded.
+ */
+uint16_t LatencyStats::getMeanTickInterval(ButtonEventType type) {
+    const Entry &entry = m_entries[static_cast<uint8_t>(type)];
+    return entry.count == 0 ? 0 : entry.tickIntervalSum / entry.count;
+}
+
+/**
+ * @brief Get number of events of a type with latency in a histogram bucket.
+ * @param type event type.
+ * @param bucket bucket index, lower than #HISTOGRAM_BUCKETS.
+ * @return a number of events, saturates at 65535. Zero for an invalid bucket index.
+ *
+ * @see getBucketLowerBound(uint8_t bucket)
+ */
+uint16_t LatencyStats::getHistogram(ButtonEventType type, uint8_t bucket) {
+    if (bucket >= HISTOGRAM_BUCKETS)
+        return 0;
+    return m_entries[static_cast<uint8_t>(type)].histogram[bucket];
+}
+
+/**
+ * @brief Get the shortest latency counted in a histogram bucket.
+ *
+ * Buckets start at 0, 8, 16, 32, 64, 128, 256 and 512 ms. Each bucket ends where the next one starts,
+ * the last one has no upper bound.
+ *
+ * @param bucket bucket index, lower than #HISTOGRAM_BUCKETS.
+ * @return lower bound of the bucket [milliseconds].
+ */
+uint16_t LatencyStats::getBucketLowerBound(uint8_t bucket) {
+    return bucket == 0 ? 0 : 4 << bucket;
+}
+
+/**
+ * @brief Forget all recorded events.
+ */
+void LatencyStats::reset() {
+    for (uint8_t i = 0; i < EVENT_TYPES; i++)
+        m_entries[i] = Entry();
+}
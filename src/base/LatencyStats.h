@@ -0,0 +1,92 @@
+/**
+ *  @file       LatencyStats.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <inttypes.h>
+#include "ButtonEvent.h"
+
+namespace jsc {
+    /**
+     * @brief Edge-to-event latency statistics of one or more buttons.
+     *
+     * Latency is the time from the tick which saw the first raw edge of an input transition until the tick which
+     * dispatched an event caused by it. Press and long press start are measured from the press edge, other events
+     * from the release edge, so e.g. click latency includes the click interval. Tick interval is the time between
+     * the tick which saw the edge and the tick before it. The physical edge happened somewhere in between, so a large
+     * tick interval points to a slow <code>loop()</code> rather than to the debounce or click interval.
+     *
+     * For every event type, minimum, maximum and mean latency are kept, together with a histogram of latencies
+     * in #HISTOGRAM_BUCKETS log-scale buckets. Statistics are recorded by buttons only if the library is built
+     * with <code>OBJECT_BUTTON_LATENCY_STATS</code> defined, see Button::setLatencyStats(LatencyStats *stats).
+     * A single object can collect statistics of several buttons.
+     */
+    class LatencyStats {
+    public:
+        /** Number of histogram buckets. Bucket 0 holds latencies below 8 ms, every next bucket is twice as wide. */
+        constexpr static uint8_t HISTOGRAM_BUCKETS = 8;
+
+        void record(ButtonEventType type, uint16_t latency, uint16_t tickInterval);
+
+        uint16_t getCount(ButtonEventType type);
+
+        uint16_t getMinLatency(ButtonEventType type);
+
+        uint16_t getMaxLatency(ButtonEventType type);
+
+        uint16_t getMeanLatency(ButtonEventType type);
+
+        uint16_t getMaxTickInterval(ButtonEventType type);
+
+        uint16_t getMeanTickInterval(ButtonEventType type);
+
+        uint16_t getHistogram(ButtonEventType type, uint8_t bucket);
+
+        static uint16_t getBucketLowerBound(uint8_t bucket);
+
+        void reset();
+
+    private:
+        /** Number of event types, one set of statistics per type */
+        constexpr static uint8_t EVENT_TYPES = static_cast<uint8_t>(ButtonEventType::REPEAT) + 1;
+
+        /**
+         * @brief Statistics of a single event type.
+         */
+        struct Entry {
+            uint16_t count; /**< Number of recorded events, saturates at 65535 */
+            uint16_t minLatency; /**< Shortest latency [milliseconds] */
+            uint16_t maxLatency; /**< Longest latency [milliseconds] */
+            uint16_t maxTickInterval; /**< Longest tick interval [milliseconds] */
+            uint32_t latencySum; /**< Sum of latencies of counted events [milliseconds] */
+            uint32_t tickIntervalSum; /**< Sum of tick intervals of counted events [milliseconds] */
+            uint16_t histogram[HISTOGRAM_BUCKETS]; /**< Event counts per latency bucket, saturate at 65535 */
+        };
+
+        Entry m_entries[EVENT_TYPES] = {};
+    };
+}
+
+#endif // LATENCY_STATS_H
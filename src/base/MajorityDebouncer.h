@@ -0,0 +1,94 @@
+/**
+ *  @file       MajorityDebouncer.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MAJORITY_DEBOUNCER_H
+#define MAJORITY_DEBOUNCER_H
+
+#include <inttypes.h>
+#include "../interfaces/IDebouncer.h"
+
+namespace jsc {
+    /**
+     * @brief Debouncer voting over the last N samples.
+     *
+     * The last <code>Samples</code> raw samples are kept as bits, debounced level is the level of the majority
+     * of them. Isolated glitches are outvoted, while a real edge is accepted once it fills more than half
+     * of the window.
+     *
+     * - Latency: <code>Samples / 2 + 1</code> ticks after a clean edge.
+     * - RAM: 2 bytes, plus a vtable pointer.
+     * - CPU: one shift and a population count of up to 16 bits per tick.
+     *
+     * @tparam Samples size of the voting window, an odd number 1 - 15.
+     */
+    template<uint8_t Samples>
+    class MajorityDebouncer : public IDebouncer {
+        static_assert(Samples >= 1 && Samples <= 15 && Samples % 2 == 1, "Majority needs an odd number of 1 - 15 samples");
+
+    public:
+        bool update(bool pressed, unsigned long now) override;
+
+        bool isSettled() override;
+
+        void reset() override;
+
+    private:
+        /** Bits of the register holding the last <code>Samples</code> samples */
+        constexpr static uint16_t MASK = static_cast<uint16_t>((1u << Samples) - 1);
+
+        uint16_t m_history = 0; /**< Raw samples, the newest one in the lowest bit */
+    };
+
+    /**
+     * @brief Filter a raw input sample.
+     * @param pressed <code>true</code> if the raw input reads as pressed.
+     * @param now timestamp of the sample, not used.
+     * @return debounced input level.
+     */
+    template<uint8_t Samples>
+    bool MajorityDebouncer<Samples>::update(bool pressed, unsigned long /*now*/) {
+        m_history = static_cast<uint16_t>(((m_history << 1) | (pressed ? 1 : 0)) & MASK);
+        return __builtin_popcount(m_history) > Samples / 2;
+    }
+
+    /**
+     * @brief Tell whether all samples in the window are equal.
+     * @return <code>true</code> if the vote cannot change without an input change.
+     */
+    template<uint8_t Samples>
+    bool MajorityDebouncer<Samples>::isSettled() {
+        return m_history == 0 || m_history == MASK;
+    }
+
+    /**
+     * @brief Forget all samples.
+     */
+    template<uint8_t Samples>
+    void MajorityDebouncer<Samples>::reset() {
+        m_history = 0;
+    }
+}
+
+#endif // MAJORITY_DEBOUNCER_H
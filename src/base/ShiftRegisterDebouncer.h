@@ -0,0 +1,100 @@
+/**
+ *  @file       ShiftRegisterDebouncer.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SHIFT_REGISTER_DEBOUNCER_H
+#define SHIFT_REGISTER_DEBOUNCER_H
+
+#include <inttypes.h>
+#include "../interfaces/IDebouncer.h"
+
+namespace jsc {
+    /**
+     * @brief Debouncer shifting samples into a register, changes level after N equal samples.
+     *
+     * The last <code>Samples</code> raw samples are kept as bits. Debounced level becomes pressed once all of them
+     * are pressed, and released once all of them are released. Any other combination keeps the previous level.
+     * Unlike IntegratorDebouncer, a single glitch restarts the count.
+     *
+     * - Latency: <code>Samples</code> ticks after the last bounce.
+     * - RAM: 2 bytes, plus a vtable pointer.
+     * - CPU: one shift and one mask comparison per tick.
+     *
+     * @tparam Samples number of equal consecutive samples needed to change the debounced level, 1 - 8.
+     */
+    template<uint8_t Samples>
+    class ShiftRegisterDebouncer : public IDebouncer {
+        static_assert(Samples >= 1 && Samples <= 8, "Shift register holds 1 - 8 samples");
+
+    public:
+        bool update(bool pressed, unsigned long now) override;
+
+        bool isSettled() override;
+
+        void reset() override;
+
+    private:
+        /** Bits of the register holding the last <code>Samples</code> samples */
+        constexpr static uint8_t MASK = static_cast<uint8_t>((1u << Samples) - 1);
+
+        uint8_t m_history = 0; /**< Raw samples, the newest one in the lowest bit */
+        bool m_pressed = false; /**< Debounced level */
+    };
+
+    /**
+     * @brief Filter a raw input sample.
+     * @param pressed <code>true</code> if the raw input reads as pressed.
+     * @param now timestamp of the sample, not used.
+     * @return debounced input level.
+     */
+    template<uint8_t Samples>
+    bool ShiftRegisterDebouncer<Samples>::update(bool pressed, unsigned long /*now*/) {
+        m_history = static_cast<uint8_t>(((m_history << 1) | (pressed ? 1 : 0)) & MASK);
+        if (m_history == MASK)
+            m_pressed = true;
+        else if (m_history == 0)
+            m_pressed = false;
+        return m_pressed;
+    }
+
+    /**
+     * @brief Tell whether all samples in the register agree with the debounced level.
+     * @return <code>true</code> if no decision is pending.
+     */
+    template<uint8_t Samples>
+    bool ShiftRegisterDebouncer<Samples>::isSettled() {
+        return m_history == (m_pressed ? MASK : 0);
+    }
+
+    /**
+     * @brief Forget all samples.
+     */
+    template<uint8_t Samples>
+    void ShiftRegisterDebouncer<Samples>::reset() {
+        m_history = 0;
+        m_pressed = false;
+    }
+}
+
+#endif // SHIFT_REGISTER_DEBOUNCER_H
@@ -0,0 +1,142 @@
+/**
+ *  @file       TickMonitor.cpp
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TickMonitor.h"
+using namespace jsc;
+
+/** Saturation value of counters */
+constexpr static uint16_t MAX_COUNT = 0xFFFF;
+
+/**
+ * @brief Set a tick budget.
+ *
+ * Callback is called on every tick which comes more than <code>budget</code> milliseconds after the previous one.
+ * Use it to log or to raise an alarm when the main loop gets too slow.
+ *
+ * @param budget largest acceptable time between two ticks [milliseconds].
+ * @param callback function to be called when a tick exceeds the budget, or <code>nullptr</code> to disable it.
+ * @param context arbitrary pointer passed to the callback. This parameter is optional.
+ */
+void TickMonitor::setBudget(unsigned long budget, TickBudgetCallback callback, void *context) {
+    m_budget = budget;
+    m_budgetCallback = callback;
+    m_budgetContext = context;
+}
+
+/**
+ * @brief Record a tick.
+ *
+ * Called by ButtonGroup before it ticks its buttons, you do not need to call it yourself.
+ *
+ * @param now current time as returned by readClock().
+ * @return time since the previous tick [milliseconds], zero for the first tick.
+ */
+unsigned long TickMonitor::onTick(unsigned long now) {
+    unsigned long gap = clockElapsed(m_lastTickTime, now);
+    bool measured = m_ticked;
+    m_lastTickTime = now;
+    m_ticked = true;
+    if (!measured)
+        return 0;
+
+    if (gap > m_maxTickGap)
+        m_maxTickGap = gap;
+
+    if (m_deadline != NO_DEADLINE && gap > m_deadline && m_lateTicks < MAX_COUNT)
+        m_lateTicks++;
+
+    if (m_budgetCallback != nullptr && gap > m_budget)
+        m_budgetCallback(gap, m_budgetContext);
+
+    return gap;
+}
+
+/**
+ * @brief Record the tightest deadline of the buttons after a tick.
+ *
+ * Called by ButtonGroup after it ticks its buttons, you do not need to call it yourself.
+ *
+ * @param deadline milliseconds until the next tick is due, or #NO_DEADLINE.
+ *
+ * @see Button::nextDeadline()
+ */
+void TickMonitor::onDeadline(unsigned long deadline) {
+    m_deadline = deadline;
+}
+
+/**
+ * @brief Record a press seen by a single tick, followed by a tick after the debounce interval.
+ *
+ * Called by ButtonGroup, you do not need to call it yourself.
+ */
+void TickMonitor::onShortPress() {
+    if (m_shortPresses < MAX_COUNT)
+        m_shortPresses++;
+}
+
+/**
+ * @brief Get the largest time between two ticks.
+ * @return tick gap in milliseconds.
+ */
+unsigned long TickMonitor::getMaxTickGap() {
+    return m_maxTickGap;
+}
+
+/**
+ * @brief Get number of ticks which came later than the tightest deadline of the buttons.
+ *
+ * Events of a button are delayed by a late tick. Occasional late ticks are harmless, but if most ticks are late,
+ * the main loop is too slow for the configured timing.
+ *
+ * @return a number of late ticks, saturates at 65535.
+ */
+uint16_t TickMonitor::getLateTickCount() {
+    return m_lateTicks;
+}
+
+/**
+ * @brief Get number of presses seen by a single tick.
+ *
+ * Such a press lasted shorter than two tick periods, but it cannot be a bounce, because the next tick came after
+ * the debounce interval. It is reported with a wrong duration, and presses shorter than a single tick period
+ * are not seen at all. Presses seen by a single tick before the debounce interval elapsed are not counted,
+ * they are bounces.
+ *
+ * @return a number of presses, saturates at 65535.
+ */
+uint16_t TickMonitor::getShortPressCount() {
+    return m_shortPresses;
+}
+
+/**
+ * @brief Forget all recorded ticks and presses. Budget stays set.
+ */
+void TickMonitor::reset() {
+    m_lastTickTime = 0;
+    m_deadline = NO_DEADLINE;
+    m_maxTickGap = 0;
+    m_lateTicks = 0;
+    m_shortPresses = 0;
+    m_ticked = false;
+}
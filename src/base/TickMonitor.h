@@ -0,0 +1,85 @@
+/**
+ *  @file       TickMonitor.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TICK_MONITOR_H
+#define TICK_MONITOR_H
+
+#include <inttypes.h>
+#include "Button.h"
+
+namespace jsc {
+    /**
+     * @brief Function called when a tick comes later than the tick budget allows.
+     * @param gap time since the previous tick [milliseconds].
+     * @param context pointer passed to TickMonitor::setBudget().
+     */
+    typedef void (*TickBudgetCallback)(unsigned long gap, void *context);
+
+    /**
+     * @brief Detector of ticks coming too rarely.
+     *
+     * If <code>tick()</code> is called too rarely, the state machine merges or loses events: a press and a release
+     * between two ticks are never seen, and a press seen by a single tick has a wrong duration. The monitor keeps
+     * the largest gap between ticks, counts ticks which came later than the tightest deadline of the buttons,
+     * and counts presses which were seen by a single tick only, although the next tick came after the debounce
+     * interval. Those presses lasted shorter than two tick periods, so even shorter ones were likely lost.
+     * An optional callback fires on every tick which comes later than a configured budget.
+     *
+     * Attach the monitor to a ButtonGroup, it is fed by the group on every tick. To monitor a single button,
+     * put it into a group of one.
+     *
+     * @see ButtonGroup::setTickMonitor(TickMonitor *monitor)
+     */
+    class TickMonitor {
+    public:
+        void setBudget(unsigned long budget, TickBudgetCallback callback, void *context = nullptr);
+
+        unsigned long onTick(unsigned long now);
+
+        void onDeadline(unsigned long deadline);
+
+        void onShortPress();
+
+        unsigned long getMaxTickGap();
+
+        uint16_t getLateTickCount();
+
+        uint16_t getShortPressCount();
+
+        void reset();
+
+    private:
+        unsigned long m_lastTickTime = 0; /**< Timestamp of the previous tick [milliseconds] */
+        unsigned long m_deadline = NO_DEADLINE; /**< Tightest deadline after the previous tick, relative to it [milliseconds] */
+        unsigned long m_maxTickGap = 0; /**< Largest time between two ticks [milliseconds] */
+        unsigned long m_budget = 0; /**< Largest acceptable time between two ticks [milliseconds] */
+        TickBudgetCallback m_budgetCallback = nullptr; /**< Called when a tick exceeds the budget */
+        void *m_budgetContext = nullptr; /**< Context pointer passed to the budget callback */
+        uint16_t m_lateTicks = 0; /**< Number of ticks later than the deadline, saturates at 65535 */
+        uint16_t m_shortPresses = 0; /**< Number of presses seen by a single tick, saturates at 65535 */
+        bool m_ticked = false; /**< Set after the first tick, gaps are measured from then on */
+    };
+}
+
+#endif // TICK_MONITOR_H
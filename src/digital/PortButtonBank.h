@@ -0,0 +1,176 @@
+/**
+ *  @file       PortButtonBank.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PORT_BUTTON_BANK_H
+#define PORT_BUTTON_BANK_H
+
+#include "../base/Button.h"
+
+namespace jsc {
+    /**
+     * @brief Bank of buttons read from a whole input port at once.
+     *
+     * Instead of calling <code>digitalRead()</code> for each button, the bank reads a port register
+     * (e.g. <code>PIND</code> on AVR) or an input word supplied by the caller in a single access.
+     * All bits are debounced at once using vertical counters: each bit owns a 2-bit counter spread
+     * over two words, so debouncing 8, 16 or 32 inputs costs a handful of bitwise operations.
+     * A bit changes its debounced state after it differs from it in 4 consecutive samples.
+     *
+     * Only buttons whose debounced bit changed, or which still wait for a timeout, are ticked.
+     * Idle buttons with a stable input cost nothing.
+     *
+     * @tparam T input word type, one of <code>uint8_t</code>, <code>uint16_t</code> or <code>uint32_t</code>.
+     */
+    template<typename T>
+    class PortButtonBank {
+    public:
+        explicit PortButtonBank(const volatile T *port = nullptr, T activeLowMask = static_cast<T>(~0));
+
+        bool attach(uint8_t bit, Button &button);
+
+        T getState() const;
+
+        void tick();
+
+        void tick(unsigned long now);
+
+        void tick(unsigned long now, T sample);
+
+    private:
+        constexpr static uint8_t BITS = sizeof(T) * 8; /**< Number of inputs in a single word */
+
+        const volatile T *m_port; /**< Input register read on each tick, can be <code>nullptr</code> */
+
+        /**
+         * Bits set to 1 are pressed when their input is <code>LOW</code>, typically buttons
+         * connected to ground with an internal pull-up resistor.
+         */
+        T m_activeLowMask;
+
+        T m_state = 0; /**< Debounced input, bit set to 1 means a pressed button */
+        T m_counter0 = 0; /**< Low bits of vertical counters */
+        T m_counter1 = 0; /**< High bits of vertical counters */
+
+        T m_attached = 0; /**< Bits with an attached button */
+        T m_busy = 0; /**< Bits with a button waiting for a timeout */
+
+        Button *m_buttons[BITS] = {}; /**< Buttons indexed by their bit */
+    };
+
+    /**
+     * @brief Constructor for the class.
+     * @param port pointer to an input port register, e.g. <code>&PIND</code>. Pass <code>nullptr</code>
+     * if you provide input words to <code>tick(now, sample)</code> yourself.
+     * @param activeLowMask bits which are pressed when their input is <code>LOW</code>.
+     * This parameter is optional and defaults to all bits.
+     */
+    template<typename T>
+    PortButtonBank<T>::PortButtonBank(const volatile T *port, T activeLowMask) :
+            m_port(port), m_activeLowMask(activeLowMask) {}
+
+    /**
+     * @brief Attach a button to a bit of the input word.
+     *
+     * Bank debounces its inputs on its own, therefore it ticks the button with Button::tickDebounced(), which skips
+     * the debounce interval of the button. Timing of the button is left untouched and can still be changed.
+     * Once attached, the button should not be ticked on its own. Bank takes care of it.
+     *
+     * @param bit position of the button input in the word.
+     * @param button a button connected to the input.
+     * @return <code>true</code> if the button was attached, <code>false</code> if the bit is out of range.
+     */
+    template<typename T>
+    bool PortButtonBank<T>::attach(uint8_t bit, Button &button) {
+        if (bit >= BITS)
+            return false;
+
+        m_buttons[bit] = &button;
+        m_attached |= static_cast<T>(static_cast<T>(1) << bit);
+        return true;
+    }
+
+    /**
+     * @brief Get debounced state of all inputs.
+     * @return input word, bit set to 1 means a pressed button.
+     */
+    template<typename T>
+    T PortButtonBank<T>::getState() const {
+        return m_state;
+    }
+
+    /**
+     * @brief Read the input port and update all attached buttons.
+     *
+     * Call this function periodically in your <code>loop()</code> function. Debounce interval
+     * equals four tick periods.
+     */
+    template<typename T>
+    void PortButtonBank<T>::tick() {
+        tick(readClock());
+    }
+
+    /**
+     * @brief Read the input port and update all attached buttons using a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     */
+    template<typename T>
+    void PortButtonBank<T>::tick(unsigned long now) {
+        if (m_port != nullptr)
+            tick(now, *m_port);
+    }
+
+    /**
+     * @brief Update all attached buttons using an input word provided by the caller.
+     * @param now current time as returned by readClock().
+     * @param sample raw input word, e.g. a value of an I/O expander register.
+     */
+    template<typename T>
+    void PortButtonBank<T>::tick(unsigned long now, T sample) {
+        T pressed = sample ^ m_activeLowMask;
+
+        // vertical counters: bits differing from the debounced state count up, stable bits reset
+        T delta = pressed ^ m_state;
+        m_counter1 = (m_counter1 ^ m_counter0) & delta;
+        m_counter0 = ~m_counter0 & delta;
+        T toggle = delta & ~(m_counter0 | m_counter1);
+        m_state ^= toggle;
+
+        T pending = (toggle | m_busy) & m_attached;
+        for (uint8_t bit = 0; pending != 0; bit++, pending >>= 1) {
+            if ((pending & 1) == 0)
+                continue;
+
+            Button *button = m_buttons[bit];
+            T mask = static_cast<T>(static_cast<T>(1) << bit);
+            button->tickDebounced(now, (m_state & mask) != 0);
+
+            if (button->isIdle())
+                m_busy &= ~mask;
+            else
+                m_busy |= mask;
+        }
+    }
+}
+
+#endif // PORT_BUTTON_BANK_H
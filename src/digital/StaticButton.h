@@ -0,0 +1,183 @@
+/**
+ *  @file       StaticButton.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATIC_BUTTON_H
+#define STATIC_BUTTON_H
+
+#include "../base/Button.h"
+
+namespace jsc {
+    /**
+     * @brief Digital button configured at compile time.
+     *
+     * Behaves exactly like DigitalButton, but its pin, input logic and timing are template parameters.
+     * <code>tick()</code> reads the input directly instead of going through the virtual
+     * <code>isButtonPressed()</code> call, and the pressed level is a compile-time constant.
+     * Timing values are checked at compile time. <code>tick()</code> and <code>nextDeadline()</code> pass them
+     * to the state machine as constants, so no timing profile is read on every tick. The state machine itself
+     * is shared with the other buttons. The button stores no input logic, its other state takes as much RAM
+     * as in DigitalButton.
+     *
+     * Timing cannot be changed at run time, therefore the timing setters are not available. A copy of the timing
+     * is kept in flash memory for code which ticks the button through a reference to Button, e.g. ButtonGroup.
+     *
+     * Listeners receive a reference to Button as usual, so StaticButton can be used with any existing listener.
+     *
+     * @tparam Pin an input pin to use for the button.
+     * @tparam InputPullUp <code>true</code> if voltage level on input pin is <code>LOW</code> after button is pressed.
+     * @tparam DebounceTicks debounce time interval in milliseconds.
+     * @tparam ClickTicks click time interval in milliseconds.
+     * @tparam LongPressTicks long press time interval in milliseconds.
+     */
+    template<uint8_t Pin,
+             bool InputPullUp = true,
+             uint16_t DebounceTicks = DEFAULT_DEBOUNCE_TICKS_MS,
+             uint16_t ClickTicks = DEFAULT_CLICK_TICKS_MS,
+             uint16_t LongPressTicks = DEFAULT_LONG_PRESS_TICKS_MS>
+    class StaticButton : public Button {
+        static_assert(DebounceTicks <= 255, "Debounce interval must fit into 8 bits");
+        static_assert(DebounceTicks < ClickTicks, "Click interval must be longer than debounce interval");
+        static_assert(DebounceTicks < LongPressTicks, "Long press interval must be longer than debounce interval");
+        static_assert(LongPressTicks <= MAX_PRESS_DURATION_MS, "Long press interval must not exceed press duration limit");
+
+    public:
+        StaticButton();
+
+        int getId() override;
+
+        void reset() override;
+
+        using Button::tick;
+
+        void tick();
+
+        void tick(unsigned long now);
+
+        unsigned long nextDeadline();
+
+        unsigned long nextDeadline(unsigned long now);
+
+    private:
+        using Button::setTiming;
+        using Button::setTimingP;
+        using Button::setDebounceTicks;
+        using Button::setClickTicks;
+        using Button::setLongPressTicks;
+
+        bool isButtonPressed() override;
+
+        /** Signal level on input pin while the button is pressed */
+        constexpr static uint8_t PRESSED_LEVEL = InputPullUp ? LOW : HIGH;
+
+        /** Timing profile given as template parameters */
+        static const ButtonTiming TIMING;
+    };
+
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    const ButtonTiming StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::TIMING PROGMEM = {
+            DebounceTicks,
+            ClickTicks,
+            LongPressTicks
+    };
+
+    /**
+     * @brief Constructor for the class.
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::StaticButton() :
+            Button(Pin, InputPullUp) {
+        setTimingP(&TIMING);
+    }
+
+    /**
+     * @brief Get button identifier.
+     * @return button ID, which corresponds to input pin number.
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    int StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::getId() {
+        return Pin;
+    }
+
+    /**
+     * @brief Reset button state.
+     *
+     * Timing is restored to values given as template parameters.
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    void StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::reset() {
+        Button::reset();
+        setTimingP(&TIMING);
+    }
+
+    /**
+     * @brief Update internal state machine.
+     *
+     * Reads the input pin directly, without a virtual call.
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    void StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::tick() {
+        tick(readClock());
+    }
+
+    /**
+     * @brief Update internal state machine using a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    void StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::tick(unsigned long now) {
+        runStateMachine(now, digitalRead(Pin) == PRESSED_LEVEL,
+                        ButtonTiming{DebounceTicks, ClickTicks, LongPressTicks});
+    }
+
+    /**
+     * @brief Tell the user when the button needs to be ticked again.
+     * @return milliseconds until the next timeout of the state machine, see Button::nextDeadline().
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    unsigned long StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::nextDeadline() {
+        return nextDeadline(readClock());
+    }
+
+    /**
+     * @brief Tell the user when the button needs to be ticked again, relative to a timestamp provided by the caller.
+     * @param now current time as returned by readClock().
+     * @return milliseconds until the next timeout of the state machine, see Button::nextDeadline().
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    unsigned long StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::nextDeadline(unsigned long now) {
+        return computeDeadline(now, ButtonTiming{DebounceTicks, ClickTicks, LongPressTicks});
+    }
+
+    /**
+     * @brief Evaluate whether a button is pressed.
+     *
+     * Used only when the button is ticked through a reference to Button, e.g. from ButtonGroup.
+     */
+    template<uint8_t Pin, bool InputPullUp, uint16_t DebounceTicks, uint16_t ClickTicks, uint16_t LongPressTicks>
+    bool StaticButton<Pin, InputPullUp, DebounceTicks, ClickTicks, LongPressTicks>::isButtonPressed() {
+        return digitalRead(Pin) == PRESSED_LEVEL;
+    }
+}
+
+#endif // STATIC_BUTTON_H
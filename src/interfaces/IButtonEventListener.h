@@ -0,0 +1,65 @@
+/**
+ *  @file       IButtonEventListener.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef I_BUTTON_EVENT_LISTENER_H
+#define I_BUTTON_EVENT_LISTENER_H
+
+#include "../base/ButtonEvent.h"
+
+namespace jsc {
+    class Button;
+
+    /**
+     * @brief Callback interface receiving all button events in a single function.
+     *
+     * Alternative to IOnClickListener, IOnDoubleClickListener and IOnPressListener. A button needs only one
+     * pointer to reach such a listener, and the listener handles all events in one <code>switch</code>
+     * over ButtonEvent::type.
+     */
+    class IButtonEventListener {
+    public:
+        /**
+         * Destructor
+         */
+        virtual ~IButtonEventListener() = default;
+
+        /**
+         * Callback function to be called when any button event occurs.
+         * @param button is a reference to the instance which called the listener.
+         * @param event describes the event.
+         */
+        virtual void onEvent(Button& button, const ButtonEvent& event) = 0;
+
+        /**
+         * Tell the button whether this listener cares about an event type. Button skips waiting for events nobody
+         * observes, e.g. it reports a click right after release if double-clicks are not observed.
+         * Implementing this function is optional, all events are observed by default.
+         * @param type event type.
+         * @return <code>true</code> if the listener handles events of this type, <code>false</code> otherwise.
+         */
+        virtual bool observes(ButtonEventType /*type*/) { return true; }
+    };
+}
+
+#endif // I_BUTTON_EVENT_LISTENER_H
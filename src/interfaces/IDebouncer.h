@@ -0,0 +1,73 @@
+/**
+ *  @file       IDebouncer.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef I_DEBOUNCER_H
+#define I_DEBOUNCER_H
+
+namespace jsc {
+    /**
+     * @brief Interface of a debouncing strategy.
+     *
+     * Button feeds every raw input sample through the debouncer set with Button::setDebouncer() and runs its state
+     * machine on the debounced level. The built-in time-window debounce of the state machine is bypassed then.
+     * A debouncer keeps state of a single input, so every button needs its own instance.
+     *
+     * Without a debouncer, a button uses the time-window strategy: a press is accepted once the input has been
+     * pressed for longer than ButtonTiming::debounceTicks since the first edge.
+     *
+     * @see IntegratorDebouncer
+     * @see ShiftRegisterDebouncer
+     * @see MajorityDebouncer
+     */
+    class IDebouncer {
+    public:
+        /**
+         * Destructor
+         */
+        virtual ~IDebouncer() = default;
+
+        /**
+         * Filter a raw input sample.
+         * @param pressed <code>true</code> if the raw input reads as pressed.
+         * @param now timestamp of the sample [milliseconds].
+         * @return debounced input level, <code>true</code> if the button is considered pressed.
+         */
+        virtual bool update(bool pressed, unsigned long now) = 0;
+
+        /**
+         * Tell whether the debounced level follows the raw input. An unsettled debouncer needs more samples
+         * to decide, so the button has to be ticked again right away.
+         * @return <code>true</code> if no decision is pending, <code>false</code> otherwise.
+         */
+        virtual bool isSettled() = 0;
+
+        /**
+         * Forget all samples, debounced level becomes released.
+         */
+        virtual void reset() = 0;
+    };
+}
+
+#endif // I_DEBOUNCER_H
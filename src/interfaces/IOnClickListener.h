@@ -46,6 +46,16 @@ namespace jsc {
          * @param button is a reference to the instance which called the listener.
          */
         virtual void onClick(Button& button) = 0;
+
+        /**
+         * Callback function to be called when a click reported in speculative mode turns out to be
+         * the first half of a double-click. It is called right before the double-click event.
+         * Implementing this function is optional.
+         * @param button is a reference to the instance which called the listener.
+         *
+         * @see Button::setSpeculativeClick(bool enabled)
+         */
+        virtual void onClickCancelled(Button& /*button*/) {}
     };
 }
 
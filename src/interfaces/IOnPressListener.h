@@ -25,6 +25,8 @@
 #ifndef I_ON_PRESS_LISTENER_H
 #define I_ON_PRESS_LISTENER_H
 
+#include <inttypes.h>
+
 namespace jsc {
     class Button;
 
@@ -64,6 +66,16 @@ namespace jsc {
          * @param button is a reference to the instance which called the listener.
          */
         virtual void onLongPressEnd(Button& button) = 0;
+
+        /**
+         * Callback function to be called on every repeat while a button is held. Repeat is disabled by default,
+         * so implementing this function is optional.
+         * @param button is a reference to the instance which called the listener.
+         * @param count number of repeats of the press so far, starting at 1 and saturating at #MAX_REPEAT_COUNT.
+         *
+         * @see Button::setRepeatTiming(const RepeatTiming &timing)
+         */
+        virtual void onRepeat(Button& /*button*/, uint8_t /*count*/) {}
     };
 }
 
@@ -180,4 +180,107 @@ unittest(receive_on_click_event_if_button_was_released_before_click_ticks_due_to
         assertEqual(0, testMock.getLongPressEndEventsReceivedCount());
 }
 
+/*
+ * Without a double-click listener, there is nothing to wait for. Click is sent right after
+ * the button is released.
+ */
+unittest(receive_on_click_event_on_release_without_double_click_listener) {
+    testMock.getButton().setOnDoubleClickListener(nullptr);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    testMock.getButton().tick();
+
+    // validate click event
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(true, testMock.getButton().isIdle());
+}
+
+unittest(receive_on_long_press_end_on_release_without_double_click_listener) {
+    testMock.getButton().setOnDoubleClickListener(nullptr);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // fire long press event
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 10) * 1000;
+    testMock.getButton().tick();
+
+    // validate long press end without click
+    assertEqual(1, testMock.getLongPressStartEventsReceivedCount());
+    assertEqual(1, testMock.getLongPressEndEventsReceivedCount());
+    assertEqual(0, testMock.getClickEventsReceivedCount());
+}
+
+unittest(receive_on_click_event_on_release_in_speculative_mode) {
+    testMock.getButton().setSpeculativeClick(true);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    // release button, click is reported right away
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+
+    // click timeout elapses, click is not reported again
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    // validate click event
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(0, testMock.getClickCancelledEventsReceivedCount());
+    assertEqual(0, testMock.getDoubleClickEventsReceivedCount());
+    assertEqual(true, testMock.getButton().isIdle());
+}
+
+unittest(long_press_is_not_reported_as_click_in_speculative_mode) {
+    testMock.getButton().setSpeculativeClick(true);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // fire long press event
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 10) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    // validate long press end without click
+    assertEqual(1, testMock.getLongPressEndEventsReceivedCount());
+    assertEqual(0, testMock.getClickEventsReceivedCount());
+}
+
 unittest_main()
\ No newline at end of file
@@ -102,4 +102,40 @@ unittest(receive_on_double_click_event_when_button_is_quickly_pressed_after_clic
     assertEqual(0, testMock.getLongPressEndEventsReceivedCount());
 }
 
+unittest(receive_on_click_cancelled_before_double_click_in_speculative_mode) {
+    testMock.getButton().setSpeculativeClick(true);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    // release button, click is reported speculatively
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = 2 * DEFAULT_DEBOUNCE_TICKS_MS * 1000;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(0, testMock.getClickCancelledEventsReceivedCount());
+
+    // press button again
+    state->digitalPin[INPUT_PIN] = LOW;
+    state->micros = (3 * DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    // release button again
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (4 * DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    // validate click is superseded by double-click
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(1, testMock.getClickCancelledEventsReceivedCount());
+    assertEqual(1, testMock.getDoubleClickEventsReceivedCount());
+}
+
 unittest_main()
\ No newline at end of file
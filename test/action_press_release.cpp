@@ -259,4 +259,97 @@ unittest(receive_long_press_start_and_end_events_when_button_is_held_longer_than
         assertEqual(1, testMock.getLongPressEndEventsReceivedCount());
 }
 
+unittest(lockout_mode_reports_press_on_first_edge) {
+    testMock.getButton().setLockoutDebounce(true);
+
+    // press button
+    state->micros = 1000 * 1000;
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // no debounce latency
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(true, testMock.getButton().isPressed());
+}
+
+unittest(lockout_mode_reports_press_right_after_boot) {
+    testMock.getButton().setLockoutDebounce(true);
+
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+}
+
+unittest(lockout_mode_ignores_press_bounce) {
+    testMock.getButton().setLockoutDebounce(true);
+
+    // bounce within lockout interval
+    for (unsigned long now = 0; now < DEFAULT_DEBOUNCE_TICKS_MS; now += 5) {
+        state->micros = now * 1000;
+        state->digitalPin[INPUT_PIN] = (now / 5) % 2 == 0 ? LOW : HIGH;
+        testMock.getButton().tick();
+    }
+    assertEqual(true, testMock.getButton().isPressed());
+
+    // button settles pressed
+    state->digitalPin[INPUT_PIN] = LOW;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(0, testMock.getReleaseEventsReceivedCount());
+}
+
+unittest(lockout_mode_reports_release_on_first_edge_and_ignores_release_bounce) {
+    testMock.getButton().setLockoutDebounce(true);
+    testMock.getButton().setOnDoubleClickListener(nullptr);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+
+    // release button after lockout expires
+    state->micros = 100 * 1000;
+    state->digitalPin[INPUT_PIN] = HIGH;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+
+    // release bounce does not start a new press
+    for (unsigned long now = 100; now <= 100 + DEFAULT_DEBOUNCE_TICKS_MS; now += 5) {
+        state->micros = now * 1000;
+        state->digitalPin[INPUT_PIN] = (now / 5) % 2 == 0 ? LOW : HIGH;
+        testMock.getButton().tick();
+    }
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+
+    // next press after lockout fires right away
+    state->micros = 200 * 1000;
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+    assertEqual(2, testMock.getPressEventsReceivedCount());
+}
+
+unittest(lockout_mode_keeps_short_tap) {
+    testMock.getButton().setLockoutDebounce(true);
+    testMock.getButton().setOnDoubleClickListener(nullptr);
+
+    // press button for less than debounce interval
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+    state->micros = 10 * 1000;
+    state->digitalPin[INPUT_PIN] = HIGH;
+    testMock.getButton().tick();
+
+    // release is reported once lockout expires
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 1 - 10, testMock.getButton().nextDeadline());
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+}
+
 unittest_main()
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+AnalogButton lowButton = AnalogButton(1, INPUT_PIN, 200, true);
+AnalogButton middleButton = AnalogButton(2, INPUT_PIN, 500, true);
+AnalogButton highButton = AnalogButton(3, INPUT_PIN, 800, true);
+ListenerMock lowMock = ListenerMock(lowButton);
+ListenerMock middleMock = ListenerMock(middleButton);
+ListenerMock highMock = ListenerMock(highButton);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    lowMock.resetState();
+    middleMock.resetState();
+    highMock.resetState();
+    state->reset();
+}
+
+/*
+ * Buttons are deliberately attached out of order. Ladder keeps them sorted by voltage.
+ */
+void pressAndHold(int voltage) {
+    AnalogLadder<3> ladder = AnalogLadder<3>(INPUT_PIN);
+    ladder.add(highButton);
+    ladder.add(lowButton);
+    ladder.add(middleButton);
+
+    // press button
+    state->analogPin[INPUT_PIN] = voltage;
+    ladder.tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    ladder.tick();
+}
+
+unittest(ladder_rejects_buttons_over_capacity) {
+    AnalogLadder<2> ladder = AnalogLadder<2>(INPUT_PIN);
+
+    assertEqual(true, ladder.add(lowButton));
+    assertEqual(true, ladder.add(middleButton));
+    assertEqual(false, ladder.add(highButton));
+    assertEqual(2, ladder.size());
+}
+
+unittest(ladder_decodes_lowest_button) {
+    pressAndHold(200 + DEFAULT_VOLTAGE_MARGIN - 1);
+
+    assertEqual(1, lowMock.getPressEventsReceivedCount());
+    assertEqual(0, middleMock.getPressEventsReceivedCount());
+    assertEqual(0, highMock.getPressEventsReceivedCount());
+}
+
+unittest(ladder_decodes_middle_button) {
+    pressAndHold(500 - DEFAULT_VOLTAGE_MARGIN + 1);
+
+    assertEqual(0, lowMock.getPressEventsReceivedCount());
+    assertEqual(1, middleMock.getPressEventsReceivedCount());
+    assertEqual(0, highMock.getPressEventsReceivedCount());
+}
+
+unittest(ladder_decodes_highest_button) {
+    pressAndHold(800);
+
+    assertEqual(0, lowMock.getPressEventsReceivedCount());
+    assertEqual(0, middleMock.getPressEventsReceivedCount());
+    assertEqual(1, highMock.getPressEventsReceivedCount());
+}
+
+unittest(voltage_between_buttons_presses_nothing) {
+    pressAndHold(650);
+
+    assertEqual(0, lowMock.getPressEventsReceivedCount());
+    assertEqual(0, middleMock.getPressEventsReceivedCount());
+    assertEqual(0, highMock.getPressEventsReceivedCount());
+}
+
+unittest(overlapping_windows_resolve_to_closer_button) {
+    lowButton.setVoltageMargin(400);
+    middleButton.setVoltageMargin(400);
+
+    pressAndHold(420);
+
+    assertEqual(0, lowMock.getPressEventsReceivedCount());
+    assertEqual(1, middleMock.getPressEventsReceivedCount());
+    assertEqual(0, highMock.getPressEventsReceivedCount());
+
+    lowButton.setVoltageMargin(DEFAULT_VOLTAGE_MARGIN);
+    middleButton.setVoltageMargin(DEFAULT_VOLTAGE_MARGIN);
+}
+
+unittest(wide_margin_reaches_beyond_neighbour_windows) {
+    highButton.setVoltageMargin(400);
+
+    // closer to the middle button, but only the high button's window contains it
+    pressAndHold(450);
+
+    assertEqual(0, lowMock.getPressEventsReceivedCount());
+    assertEqual(0, middleMock.getPressEventsReceivedCount());
+    assertEqual(1, highMock.getPressEventsReceivedCount());
+
+    highButton.setVoltageMargin(DEFAULT_VOLTAGE_MARGIN);
+}
+
+unittest(wide_margin_below_reaches_beyond_neighbour_windows) {
+    lowButton.setVoltageMargin(400);
+
+    pressAndHold(560);
+
+    assertEqual(1, lowMock.getPressEventsReceivedCount());
+    assertEqual(0, middleMock.getPressEventsReceivedCount());
+    assertEqual(0, highMock.getPressEventsReceivedCount());
+
+    lowButton.setVoltageMargin(DEFAULT_VOLTAGE_MARGIN);
+}
+
+unittest(ladder_uses_voltage_provided_by_caller) {
+    AnalogLadder<3> ladder = AnalogLadder<3>(INPUT_PIN);
+    ladder.add(lowButton);
+    ladder.add(middleButton);
+    ladder.add(highButton);
+
+    state->analogPin[INPUT_PIN] = 0;
+    ladder.tick(0, 500);
+    ladder.tick(DEFAULT_DEBOUNCE_TICKS_MS + 1, 500);
+
+    assertEqual(1, middleMock.getPressEventsReceivedCount());
+}
+
+unittest_main()
@@ -0,0 +1,203 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+ListenerMock testMock = ListenerMock(digitalButton);
+EventListenerMock eventMock;
+
+/*
+ * Repeat profiles stay registered for good, so tests share a few constant ones.
+ */
+const RepeatTiming FLASH_TIMING PROGMEM = {100, 100, 100, 0};
+const RepeatTiming ACCELERATING_TIMING = {100, 100, 10, 5};
+
+/*
+ * Time of the n-th repeat of a press at zero with DEFAULT_REPEAT_TIMING, computed repeat by repeat.
+ */
+static unsigned long expectedRepeatTime(uint16_t n) {
+    unsigned long time = DEFAULT_LONG_PRESS_TICKS_MS;
+    for (uint16_t i = 1; i < n; i++) {
+        long interval = 200 - 25L * (i - 1);
+        time += interval > 50 ? interval : 50;
+    }
+    return time + 1;
+}
+
+/*
+ * Hold the button from <code>from</code> until <code>to</code>, ticking every millisecond.
+ */
+static void hold(unsigned long from, unsigned long to) {
+    for (unsigned long now = from; now < to; now++)
+        digitalButton.tick(now, true);
+}
+
+unittest_setup() {
+    digitalButton.clearRepeatTiming();
+    testMock.resetState();
+    eventMock.resetState();
+    digitalButton.setEventListener(&eventMock);
+}
+
+unittest(held_button_does_not_repeat_by_default) {
+    hold(0, 3000);
+    digitalButton.tick(3000, false);
+    digitalButton.tick(3001, false);
+
+    assertEqual(0, testMock.getRepeatEventsReceivedCount());
+    assertEqual(0, digitalButton.getRepeatCount());
+    assertEqual(1, testMock.getLongPressEndEventsReceivedCount());
+}
+
+unittest(repeats_accelerate_down_to_minimum_interval) {
+    assertTrue(digitalButton.setRepeatTiming(DEFAULT_REPEAT_TIMING));
+
+    unsigned long now = 0;
+    for (uint16_t n = 1; n <= 12; n++) {
+        while (testMock.getRepeatEventsReceivedCount() < n && now < 5000)
+            digitalButton.tick(now++, true);
+
+        assertEqual(expectedRepeatTime(n), eventMock.getLastEvent().time);
+        assertEqual(n, testMock.getLastRepeatCount());
+        assertEqual(n, eventMock.getLastEvent().clickCount);
+        assertEqual(expectedRepeatTime(n), eventMock.getLastEvent().pressDuration);
+    }
+
+    // intervals of the last repeats are at the minimum
+    assertEqual(50, expectedRepeatTime(12) - expectedRepeatTime(11));
+    assertEqual(1, testMock.getLongPressStartEventsReceivedCount());
+}
+
+unittest(repeated_press_is_not_a_click) {
+    assertTrue(digitalButton.setRepeatTimingP(&FLASH_TIMING));
+
+    hold(0, 350);
+    digitalButton.tick(350, false);
+    digitalButton.tick(1000, false);
+
+    assertEqual(3, testMock.getRepeatEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(0, testMock.getClickEventsReceivedCount());
+    assertEqual(0, testMock.getLongPressEndEventsReceivedCount());
+    assertTrue(digitalButton.isIdle());
+
+    // count stays readable after release, a short press does not repeat and clicks again
+    assertEqual(3, digitalButton.getRepeatCount());
+    hold(2000, 2100);
+    digitalButton.tick(2100, false);
+    digitalButton.tick(3000, false);
+    assertEqual(0, digitalButton.getRepeatCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+}
+
+unittest(deadline_points_to_next_repeat) {
+    assertTrue(digitalButton.setRepeatTiming(DEFAULT_REPEAT_TIMING));
+
+    // tick by deadline only
+    unsigned long now = 0;
+    digitalButton.tick(now, true);
+    for (int i = 0; i < 40 && testMock.getRepeatEventsReceivedCount() < 10; i++) {
+        now += digitalButton.nextDeadline(now);
+        digitalButton.tick(now, true);
+    }
+
+    assertEqual(10, testMock.getRepeatEventsReceivedCount());
+    assertEqual(expectedRepeatTime(10), now);
+    assertEqual(50, digitalButton.nextDeadline(now));
+}
+
+unittest(late_tick_catches_up_without_drift) {
+    assertTrue(digitalButton.setRepeatTimingP(&FLASH_TIMING));
+
+    digitalButton.tick(0, true);
+    digitalButton.tick(60, true);
+
+    // three repeats are due at once, one is sent per tick
+    digitalButton.tick(350, true);
+    assertEqual(1, testMock.getRepeatEventsReceivedCount());
+    assertEqual(0, digitalButton.nextDeadline(350));
+    digitalButton.tick(350, true);
+    digitalButton.tick(350, true);
+    assertEqual(3, testMock.getRepeatEventsReceivedCount());
+
+    // fourth repeat keeps the original schedule
+    assertEqual(51, digitalButton.nextDeadline(350));
+}
+
+unittest(repeats_go_on_beyond_timestamp_range) {
+    assertTrue(digitalButton.setRepeatTiming(DEFAULT_REPEAT_TIMING));
+
+    unsigned long now = 0;
+    digitalButton.tick(now, true);
+    while (now < 70000UL) {
+        now += digitalButton.nextDeadline(now);
+        digitalButton.tick(now, true);
+    }
+
+    assertEqual(MAX_REPEAT_COUNT, digitalButton.getRepeatCount());
+    assertEqual(MAX_PRESS_DURATION_MS, eventMock.getLastEvent().pressDuration);
+
+    digitalButton.tick(now + 1, false);
+    assertEqual(1, testMock.getLongPressEndEventsReceivedCount());
+    assertEqual(MAX_PRESS_DURATION_MS, eventMock.getLastEvent().pressDuration);
+}
+
+unittest(count_saturates_and_interval_stops_shrinking) {
+    assertTrue(digitalButton.setRepeatTiming(ACCELERATING_TIMING));
+
+    unsigned long now = 0;
+    digitalButton.tick(now, true);
+    while (testMock.getRepeatEventsReceivedCount() < 20) {
+        now += digitalButton.nextDeadline(now);
+        digitalButton.tick(now, true);
+    }
+
+    assertEqual(MAX_REPEAT_COUNT, testMock.getLastRepeatCount());
+    assertEqual(MAX_REPEAT_COUNT, eventMock.getLastEvent().clickCount);
+    assertEqual(100 - 5 * (MAX_REPEAT_COUNT - 1), digitalButton.nextDeadline(now));
+}
+
+// fills the table of repeat profiles, keep it the last test
+unittest(profile_is_not_set_when_table_is_full) {
+    const static RepeatTiming timings[OBJECT_BUTTON_REPEAT_TIMINGS] = {};
+    assertTrue(digitalButton.setRepeatTimingP(&FLASH_TIMING));
+
+    // at least one entry is taken already
+    bool registered = true;
+    for (const RepeatTiming &timing : timings)
+        registered = digitalButton.setRepeatTiming(timing);
+    assertFalse(registered);
+    assertTrue(digitalButton.setRepeatTiming(DEFAULT_REPEAT_TIMING));
+
+    // a profile in RAM at the address of a profile in flash is a different profile
+    assertFalse(digitalButton.setRepeatTiming(FLASH_TIMING));
+
+    // button which failed to switch repeats with its previous profile
+    hold(0, DEFAULT_LONG_PRESS_TICKS_MS + 1);
+    assertEqual(0, testMock.getRepeatEventsReceivedCount());
+    hold(DEFAULT_LONG_PRESS_TICKS_MS + 1, DEFAULT_LONG_PRESS_TICKS_MS + 2);
+    assertEqual(1, testMock.getRepeatEventsReceivedCount());
+}
+
+unittest_main()
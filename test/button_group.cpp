@@ -0,0 +1,99 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN_1 = 10;
+constexpr static byte INPUT_PIN_2 = 11;
+
+DigitalButton digitalButton1 = DigitalButton(INPUT_PIN_1, true);
+DigitalButton digitalButton2 = DigitalButton(INPUT_PIN_2, true);
+ListenerMock testMock1 = ListenerMock(digitalButton1);
+ListenerMock testMock2 = ListenerMock(digitalButton2);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    testMock1.resetState();
+    testMock2.resetState();
+    state->reset();
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+}
+
+unittest(group_rejects_buttons_over_capacity) {
+    ButtonGroup<1> group;
+
+    assertEqual(true, group.add(digitalButton1));
+    assertEqual(false, group.add(digitalButton2));
+    assertEqual(1, group.size());
+    assertEqual(INPUT_PIN_1, group.get(0).getId());
+}
+
+unittest(group_tick_delivers_events_to_all_buttons) {
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+
+    // press button 1 only
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    group.tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    group.tick();
+
+    // press button 2 as well
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    group.tick();
+
+    // release button 1
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    state->micros = (2 * DEFAULT_DEBOUNCE_TICKS_MS + 2) * 1000;
+    group.tick();
+
+    // wait for click timeout
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    group.tick();
+
+    assertEqual(1, testMock1.getPressEventsReceivedCount());
+    assertEqual(1, testMock1.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock1.getClickEventsReceivedCount());
+
+    assertEqual(1, testMock2.getPressEventsReceivedCount());
+    assertEqual(0, testMock2.getReleaseEventsReceivedCount());
+    assertEqual(0, testMock2.getClickEventsReceivedCount());
+    assertEqual(true, digitalButton2.isPressed());
+}
+
+unittest(group_tick_with_explicit_timestamp_ignores_clock) {
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+
+    // press both buttons, clock stays at zero
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    group.tick(0);
+    group.tick(DEFAULT_DEBOUNCE_TICKS_MS + 1);
+
+    assertEqual(1, testMock1.getPressEventsReceivedCount());
+    assertEqual(1, testMock2.getPressEventsReceivedCount());
+}
+
+unittest_main()
@@ -0,0 +1,138 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+constexpr static byte OTHER_INPUT_PIN = 11;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+DigitalButton otherButton = DigitalButton(OTHER_INPUT_PIN, true);
+ListenerMock testMock = ListenerMock(digitalButton);
+GodmodeState* state = GODMODE();
+
+ButtonTiming panelTiming = {10, 100, 300};
+const ButtonTiming FLASH_TIMING PROGMEM = {20, 200, 400};
+
+unittest_setup() {
+    testMock.resetState();
+    otherButton.reset();
+    state->reset();
+}
+
+void press() {
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+}
+
+unittest(default_timing_is_used_after_reset) {
+    ButtonTiming timing = testMock.getButton().getTiming();
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS, timing.debounceTicks);
+    assertEqual(DEFAULT_CLICK_TICKS_MS, timing.clickTicks);
+    assertEqual(DEFAULT_LONG_PRESS_TICKS_MS, timing.longPressTicks);
+}
+
+unittest(shared_profile_sets_debounce) {
+    testMock.getButton().setTiming(panelTiming);
+    press();
+
+    state->micros = (panelTiming.debounceTicks + 1) * 1000;
+    testMock.getButton().tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+}
+
+unittest(changing_shared_profile_retunes_all_buttons) {
+    testMock.getButton().setTiming(panelTiming);
+    otherButton.setTiming(panelTiming);
+
+    panelTiming.longPressTicks = 350;
+
+    assertEqual(350, testMock.getButton().getTiming().longPressTicks);
+    assertEqual(350, otherButton.getTiming().longPressTicks);
+
+    panelTiming.longPressTicks = 300;
+}
+
+unittest(profile_in_flash_is_read_on_tick) {
+    testMock.getButton().setTimingP(&FLASH_TIMING);
+    assertEqual(200, testMock.getButton().getTiming().clickTicks);
+
+    press();
+    state->micros = (FLASH_TIMING.longPressTicks + 1) * 1000;
+    testMock.getButton().tick();
+    testMock.getButton().tick();
+
+    assertEqual(1, testMock.getLongPressStartEventsReceivedCount());
+}
+
+unittest(setter_keeps_other_values_of_profile) {
+    testMock.getButton().setTiming(panelTiming);
+    testMock.getButton().setClickTicks(150);
+
+    ButtonTiming timing = testMock.getButton().getTiming();
+    assertEqual(panelTiming.debounceTicks, timing.debounceTicks);
+    assertEqual(150, timing.clickTicks);
+    assertEqual(panelTiming.longPressTicks, timing.longPressTicks);
+
+    // button keeps its own copy, the shared profile does not change
+    assertEqual(100, panelTiming.clickTicks);
+}
+
+unittest(setters_of_many_buttons_keep_distinct_values) {
+    DigitalButton buttons[8] = {
+            DigitalButton(1), DigitalButton(2), DigitalButton(3), DigitalButton(4),
+            DigitalButton(5), DigitalButton(6), DigitalButton(7), DigitalButton(8)
+    };
+
+    for (uint8_t i = 0; i < 8; i++) {
+        buttons[i].setDebounceTicks(10 + i);
+        buttons[i].setLongPressTicks(1000 + i);
+    }
+
+    for (uint8_t i = 0; i < 8; i++) {
+        assertEqual(10 + i, buttons[i].getTiming().debounceTicks);
+        assertEqual(DEFAULT_CLICK_TICKS_MS, buttons[i].getTiming().clickTicks);
+        assertEqual(1000 + i, buttons[i].getTiming().longPressTicks);
+    }
+}
+
+unittest(copy_of_button_does_not_share_its_timing) {
+    otherButton.setDebounceTicks(10);
+    {
+        DigitalButton copy = otherButton;
+        assertEqual(10, copy.getTiming().debounceTicks);
+        copy.setDebounceTicks(20);
+    }
+
+    testMock.getButton().setDebounceTicks(99);
+    assertEqual(10, otherButton.getTiming().debounceTicks);
+}
+
+unittest(shared_profile_replaces_own_timing) {
+    testMock.getButton().setDebounceTicks(5);
+    testMock.getButton().setTiming(panelTiming);
+    assertEqual(panelTiming.debounceTicks, testMock.getButton().getTiming().debounceTicks);
+
+    testMock.getButton().setDebounceTicks(5);
+    testMock.getButton().reset();
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS, testMock.getButton().getTiming().debounceTicks);
+}
+
+unittest_main()
@@ -0,0 +1,157 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+GodmodeState* state = GODMODE();
+
+int clickCount = 0;
+int pressCount = 0;
+Button *lastButton = nullptr;
+
+void countClick(Button &button, void *context) {
+    clickCount++;
+    lastButton = &button;
+}
+
+void countIntoContext(Button &button, void *context) {
+    (*static_cast<int *>(context))++;
+}
+
+unittest_setup() {
+    digitalButton.reset();
+    digitalButton.setCallbacks(nullptr);
+    state->reset();
+    clickCount = 0;
+    pressCount = 0;
+    lastButton = nullptr;
+}
+
+void click() {
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    digitalButton.tick();
+}
+
+unittest(function_callbacks_receive_button_and_context) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnClick(countClick);
+    callbacks.setOnPress(countIntoContext, &pressCount);
+    digitalButton.setCallbacks(&callbacks);
+
+    click();
+
+    // no double-click callback, click is reported on release
+    assertEqual(1, pressCount);
+    assertEqual(1, clickCount);
+    assertEqual(&digitalButton, lastButton);
+}
+
+unittest(double_click_callback_delays_click) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnClick(countClick);
+    callbacks.setOnDoubleClick(countIntoContext, &pressCount);
+    digitalButton.setCallbacks(&callbacks);
+
+    click();
+    assertEqual(0, clickCount);
+
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    assertEqual(1, clickCount);
+}
+
+unittest(captureless_lambda_converts_to_callback) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnClick([](Button &button, void *context) { clickCount++; });
+    digitalButton.setCallbacks(&callbacks);
+
+    click();
+
+    assertEqual(1, clickCount);
+}
+
+unittest(inline_callback_stores_lambda_with_captures) {
+    int clicks = 0;
+    int *counter = &clicks;
+    InlineCallback<> increment = [counter, &clicks](Button &button) { (*counter)++; clicks++; };
+
+    ButtonCallbacks callbacks;
+    callbacks.set(ButtonEventType::CLICK, increment);
+    digitalButton.setCallbacks(&callbacks);
+
+    click();
+
+    assertEqual(2, clicks);
+}
+
+DigitalButton otherButton = DigitalButton(INPUT_PIN + 1, true);
+
+unittest(table_is_shared_by_buttons) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnClick(countClick);
+    digitalButton.setCallbacks(&callbacks);
+    otherButton.setCallbacks(&callbacks);
+
+    click();
+    assertEqual(&digitalButton, lastButton);
+
+    state->digitalPin[INPUT_PIN + 1] = LOW;
+    otherButton.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS * 2 + 20) * 1000;
+    otherButton.tick();
+    state->digitalPin[INPUT_PIN + 1] = HIGH;
+    otherButton.tick();
+
+    assertEqual(2, clickCount);
+    assertEqual(&otherButton, lastButton);
+    otherButton.setCallbacks(nullptr);
+}
+
+unittest(callbacks_run_next_to_event_listener) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnPress(countIntoContext, &pressCount);
+    EventQueue<4> queue;
+    digitalButton.setCallbacks(&callbacks);
+    digitalButton.setEventListener(&queue);
+
+    click();
+
+    assertEqual(1, pressCount);
+    ButtonEvent event;
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::PRESS), static_cast<int>(event.type));
+    digitalButton.setEventListener(nullptr);
+}
+
+unittest(empty_inline_callback_does_nothing) {
+    InlineCallback<> empty;
+    InlineCallback<> copy = empty;
+    copy(digitalButton);
+
+    assertEqual(0, clickCount);
+}
+
+unittest_main()
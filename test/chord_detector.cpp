@@ -0,0 +1,259 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN_1 = 10;
+constexpr static byte INPUT_PIN_2 = 11;
+constexpr static byte INPUT_PIN_3 = 12;
+
+constexpr static uint32_t CHORD_AB = (1UL << 0) | (1UL << 1);
+
+DigitalButton digitalButton1 = DigitalButton(INPUT_PIN_1, true);
+DigitalButton digitalButton2 = DigitalButton(INPUT_PIN_2, true);
+DigitalButton digitalButton3 = DigitalButton(INPUT_PIN_3, true);
+EventListenerMock testMock1;
+EventListenerMock testMock2;
+GodmodeState* state = GODMODE();
+
+/*
+ * Events received by the chord callback, indexed by event type.
+ */
+int chordEvents[3];
+uint8_t lastChord;
+
+static void onChord(uint8_t chord, ChordEventType type, void *context) {
+    chordEvents[static_cast<int>(type)]++;
+    lastChord = chord;
+}
+
+static int chordEventCount(ChordEventType type) {
+    return chordEvents[static_cast<int>(type)];
+}
+
+/*
+ * Tick the detector every millisecond from <code>from</code> until <code>to</code>, excluding <code>to</code>.
+ */
+template<uint8_t Chords, uint16_t N>
+static void run(ChordDetector<Chords> &detector, ButtonGroup<N> &group, unsigned long from, unsigned long to) {
+    for (unsigned long now = from; now < to; now++)
+        detector.tick(group, now);
+}
+
+unittest_setup() {
+    digitalButton1.reset();
+    digitalButton2.reset();
+    digitalButton3.reset();
+    digitalButton1.setEventListener(&testMock1);
+    digitalButton2.setEventListener(&testMock2);
+    testMock1.resetState();
+    testMock2.resetState();
+    testMock1.setDoubleClickObserved(false);
+    testMock2.setDoubleClickObserved(false);
+    state->reset();
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+    state->digitalPin[INPUT_PIN_3] = HIGH;
+    for (int i = 0; i < 3; i++)
+        chordEvents[i] = 0;
+    lastChord = 0xFF;
+}
+
+unittest(detector_rejects_single_buttons_and_chords_over_capacity) {
+    ChordDetector<1> detector;
+
+    assertFalse(detector.add(0));
+    assertFalse(detector.add(1UL << 3));
+    assertTrue(detector.add(CHORD_AB));
+    assertFalse(detector.add((1UL << 1) | (1UL << 2)));
+    assertEqual(1, detector.size());
+}
+
+unittest(held_button_ignores_bounce) {
+    digitalButton1.tick(1000, true);
+    assertTrue(digitalButton1.isPressed());
+    assertFalse(digitalButton1.isHeld());
+
+    digitalButton1.tick(1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    assertTrue(digitalButton1.isHeld());
+
+    digitalButton1.tick(1100, false);
+    assertFalse(digitalButton1.isHeld());
+}
+
+unittest(chord_press_suppresses_member_clicks) {
+    ButtonGroup<3> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+    group.add(digitalButton3);
+    ChordDetector<2> detector;
+    detector.add((1UL << 0) | (1UL << 2));
+    detector.add(CHORD_AB);
+    detector.setCallback(onChord);
+
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    run(detector, group, 1000, 1030);
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1030, 1200);
+
+    assertEqual(1, chordEventCount(ChordEventType::PRESS));
+    assertEqual(1, lastChord);
+    assertTrue(detector.isPressed(1));
+    assertFalse(detector.isPressed(0));
+
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    run(detector, group, 1200, 1250);
+    assertEqual(1, chordEventCount(ChordEventType::RELEASE));
+    assertFalse(detector.isPressed(1));
+
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+    run(detector, group, 1250, 1300);
+
+    // buttons still report press and release, but no clicks
+    assertEqual(1, testMock1.getEventsReceivedCount(ButtonEventType::PRESS));
+    assertEqual(1, testMock1.getEventsReceivedCount(ButtonEventType::RELEASE));
+    assertEqual(0, testMock1.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(1, testMock2.getEventsReceivedCount(ButtonEventType::RELEASE));
+    assertEqual(0, testMock2.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(0, chordEventCount(ChordEventType::LONG_PRESS));
+}
+
+unittest(buttons_pressed_outside_window_are_separate_clicks) {
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+    ChordDetector<1> detector;
+    detector.add(CHORD_AB);
+    detector.setCallback(onChord);
+
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    run(detector, group, 1000, 1000 + DEFAULT_CHORD_WINDOW_TICKS_MS + 50);
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1150, 1300);
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+    run(detector, group, 1300, 1400);
+
+    assertEqual(0, chordEventCount(ChordEventType::PRESS));
+    assertEqual(1, testMock1.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(1, testMock2.getEventsReceivedCount(ButtonEventType::CLICK));
+
+    // window starts over once all buttons are released
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1400, 1500);
+    assertEqual(1, chordEventCount(ChordEventType::PRESS));
+}
+
+unittest(chord_long_press_is_reported_once_by_deadline) {
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+    ChordDetector<1> detector;
+    detector.add(CHORD_AB, 3000);
+    detector.setCallback(onChord);
+
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1000, 1100);
+    assertTrue(detector.isPressed(0));
+
+    // chord was pressed when both buttons passed debounce
+    unsigned long pressTime = 1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1;
+    assertEqual(3000 + 1 - (1100 - pressTime), detector.nextDeadline(1100));
+
+    detector.tick(group, pressTime + 3000);
+    assertEqual(0, chordEventCount(ChordEventType::LONG_PRESS));
+    detector.tick(group, pressTime + 3001);
+    assertEqual(1, chordEventCount(ChordEventType::LONG_PRESS));
+    assertEqual(NO_DEADLINE, detector.nextDeadline(pressTime + 3001));
+
+    run(detector, group, pressTime + 3002, pressTime + 4000);
+    assertEqual(1, chordEventCount(ChordEventType::LONG_PRESS));
+    assertTrue(detector.isPressed(0));
+
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    run(detector, group, pressTime + 4000, pressTime + 4100);
+    assertEqual(1, chordEventCount(ChordEventType::RELEASE));
+}
+
+unittest(chord_is_pressed_again_only_after_all_buttons_are_released) {
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+    ChordDetector<1> detector;
+    detector.add(CHORD_AB);
+    detector.setCallback(onChord);
+
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1000, 1100);
+
+    // re-press one button while the other one is still held
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    run(detector, group, 1100, 1200);
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    run(detector, group, 1200, 1300);
+    assertEqual(1, chordEventCount(ChordEventType::PRESS));
+    assertEqual(1, chordEventCount(ChordEventType::RELEASE));
+
+    state->digitalPin[INPUT_PIN_1] = HIGH;
+    state->digitalPin[INPUT_PIN_2] = HIGH;
+    run(detector, group, 1300, 1400);
+    state->digitalPin[INPUT_PIN_1] = LOW;
+    state->digitalPin[INPUT_PIN_2] = LOW;
+    run(detector, group, 1400, 1500);
+    assertEqual(2, chordEventCount(ChordEventType::PRESS));
+}
+
+unittest(suppressed_gesture_ends_right_after_release) {
+    testMock1.setDoubleClickObserved(true);
+
+    digitalButton1.tick(1000, true);
+    digitalButton1.tick(1100, true);
+    digitalButton1.suppressClicks();
+    digitalButton1.tick(1200, false);
+    assertTrue(digitalButton1.isIdle());
+
+    digitalButton1.tick(1500, false);
+    assertEqual(1, testMock1.getEventsReceivedCount(ButtonEventType::RELEASE));
+    assertEqual(0, testMock1.getEventsReceivedCount(ButtonEventType::CLICK));
+
+    // next gesture is reported again
+    digitalButton1.tick(2000, true);
+    digitalButton1.tick(2100, true);
+    digitalButton1.tick(2200, false);
+    digitalButton1.tick(2500, false);
+    assertEqual(1, testMock1.getEventsReceivedCount(ButtonEventType::CLICK));
+}
+
+unittest(update_accepts_bitmask_of_held_buttons) {
+    ChordDetector<1> detector;
+    detector.add((1UL << 4) | (1UL << 31));
+    detector.setCallback(onChord);
+
+    assertEqual(0UL, detector.update(1UL << 31, 1000));
+    assertEqual((1UL << 4) | (1UL << 31), detector.update((1UL << 4) | (1UL << 31) | 1, 1050));
+    assertEqual(0UL, detector.update((1UL << 4) | (1UL << 31), 1060));
+    assertEqual(1, chordEventCount(ChordEventType::PRESS));
+}
+
+unittest_main()
@@ -0,0 +1,160 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+GodmodeState* state = GODMODE();
+
+unsigned long simulatedTime = 0;
+
+static unsigned long simulatedClock() {
+    return simulatedTime;
+}
+
+static unsigned long simulatedTimer16() {
+    return simulatedTime & 0xFFFF;
+}
+
+static void tickAt(unsigned long time, bool pressed) {
+    simulatedTime = time;
+    state->digitalPin[INPUT_PIN] = pressed ? LOW : HIGH;
+    digitalButton.tick();
+}
+
+unittest_setup() {
+    setClock(nullptr);
+    simulatedTime = 0;
+    state->reset();
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    testMock.resetState();
+    testMock.setDoubleClickObserved(false);
+}
+
+unittest_teardown() {
+    setClock(nullptr);
+}
+
+unittest(default_clock_is_millis) {
+    state->micros = 5000;
+    assertEqual(5, readClock());
+}
+
+unittest(button_reads_custom_clock) {
+    setClock(simulatedClock);
+    state->micros = 0;
+
+    tickAt(1000, true);
+    tickAt(1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+    assertEqual(1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, testMock.getLastEvent().time);
+    assertEqual(DEFAULT_LONG_PRESS_TICKS_MS - DEFAULT_DEBOUNCE_TICKS_MS, digitalButton.nextDeadline());
+}
+
+unittest(microsecond_clock_gives_sub_millisecond_debounce) {
+    // fast optical sensor, debounce for 200 us
+    setClock(simulatedClock);
+    ButtonTiming timing = {200, 5000, 20000};
+    digitalButton.setTiming(timing);
+
+    tickAt(0, true);
+    tickAt(200, true);
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+    tickAt(201, true);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+    tickAt(700, false);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(700, testMock.getLastEvent().pressDuration);
+}
+
+unittest(button_works_with_16_bit_timer) {
+    setClock(simulatedTimer16, 16);
+
+    tickAt(65500UL, true);
+    tickAt(65500UL + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+    tickAt(65600UL, false);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(100, testMock.getLastEvent().pressDuration);
+}
+
+unittest(elapsed_time_wraps_with_clock_width) {
+    setClock(simulatedTimer16, 16);
+
+    assertEqual(10, clockElapsed(65530UL, 4));
+    assertTrue(clockBefore(65530UL, 4));
+    assertFalse(clockBefore(4, 65530UL));
+    assertFalse(clockBefore(4, 4));
+
+    setClock(simulatedClock);
+    assertEqual(65526UL, clockElapsed(4, 65530UL));
+    assertTrue(clockBefore(4, 65530UL));
+}
+
+unittest(tick_monitor_measures_gap_across_16_bit_wrap) {
+    setClock(simulatedTimer16, 16);
+    TickMonitor monitor;
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    simulatedTime = 65530UL;
+    group.tick();
+    simulatedTime = 65545UL;
+    group.tick();
+
+    assertEqual(15, monitor.getMaxTickGap());
+}
+
+unittest(edge_capture_keeps_order_across_16_bit_wrap) {
+    setClock(simulatedTimer16, 16);
+    EdgeCapture<8, 1> capture;
+    uint8_t source = capture.add(digitalButton);
+
+    simulatedTime = 65500UL;
+    capture.capture(source, true);
+    simulatedTime = 65600UL;
+    capture.capture(source, false);
+    capture.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(100, testMock.getLastEvent().pressDuration);
+}
+
+unittest(million_simulated_ticks) {
+    setClock(simulatedClock);
+
+    // press for 100 ms every second, ticked every millisecond
+    for (unsigned long time = 0; time < 1000000UL; time++) {
+        simulatedTime = time;
+        digitalButton.tick(time, time % 1000 < 100);
+    }
+
+    assertEqual(1000, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(100, testMock.getLastEvent().pressDuration);
+}
+
+unittest_main()
@@ -0,0 +1,137 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+ListenerMock testMock = ListenerMock(digitalButton);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    // debouncers of previous tests are gone
+    testMock.getButton().setDebouncer(nullptr);
+    testMock.resetState();
+    state->reset();
+}
+
+/*
+ * Feed a debouncer with samples given as a string, '1' for pressed and '0' for released.
+ * Tell whether debounced levels match the expected ones, given in the same format.
+ */
+bool debounces(IDebouncer &debouncer, const char *samples, const char *expected) {
+    bool matches = true;
+    for (; *samples != '\0' && *expected != '\0'; samples++, expected++) {
+        if (debouncer.update(*samples == '1', 0) != (*expected == '1'))
+            matches = false;
+    }
+    return matches && *samples == *expected;
+}
+
+unittest(integrator_rejects_single_glitches) {
+    IntegratorDebouncer<3> debouncer;
+    assertTrue(debounces(debouncer, "1101111101000", "0000111111110"));
+}
+
+unittest(integrator_settles_when_saturated) {
+    IntegratorDebouncer<3> debouncer;
+    assertTrue(debouncer.isSettled());
+    debouncer.update(true, 0);
+    assertFalse(debouncer.isSettled());
+    debouncer.update(true, 0);
+    debouncer.update(true, 0);
+    assertTrue(debouncer.isSettled());
+
+    debouncer.reset();
+    assertTrue(debouncer.isSettled());
+    assertFalse(debouncer.update(false, 0));
+}
+
+unittest(shift_register_needs_consecutive_equal_samples) {
+    ShiftRegisterDebouncer<3> debouncer;
+    assertTrue(debounces(debouncer, "1101111101000", "0000011111110"));
+}
+
+unittest(majority_follows_most_samples_in_window) {
+    MajorityDebouncer<5> debouncer;
+    assertTrue(debounces(debouncer, "1101111101000", "0001111111100"));
+}
+
+unittest(majority_settles_when_window_is_uniform) {
+    MajorityDebouncer<3> debouncer;
+    assertTrue(debounces(debouncer, "111", "011"));
+    assertTrue(debouncer.isSettled());
+    assertTrue(debounces(debouncer, "0", "1"));
+    assertFalse(debouncer.isSettled());
+}
+
+unittest(button_with_debouncer_reports_press_after_samples) {
+    IntegratorDebouncer<4> debouncer;
+    testMock.getButton().setDebouncer(&debouncer);
+
+    // press button, time-window debounce is not applied
+    state->digitalPin[INPUT_PIN] = LOW;
+    for (unsigned long now = 0; now < 4; now++) {
+        state->micros = now * 1000;
+        testMock.getButton().tick();
+    }
+    assertEqual(0, testMock.getPressEventsReceivedCount());
+
+    state->micros = 4 * 1000;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+}
+
+unittest(glitch_while_held_does_not_release_button) {
+    IntegratorDebouncer<4> debouncer;
+    testMock.getButton().setDebouncer(&debouncer);
+
+    unsigned long now = 0;
+    const char *samples = "11111111011111111101111111";
+    for (const char *sample = samples; *sample != '\0'; sample++) {
+        state->digitalPin[INPUT_PIN] = *sample == '1' ? LOW : HIGH;
+        state->micros = now++ * 1000;
+        testMock.getButton().tick();
+    }
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(0, testMock.getReleaseEventsReceivedCount());
+}
+
+unittest(unsettled_debouncer_needs_tick_right_away) {
+    ShiftRegisterDebouncer<4> debouncer;
+    testMock.getButton().setDebouncer(&debouncer);
+    assertEqual(NO_DEADLINE, testMock.getButton().nextDeadline());
+
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+    assertEqual(0, testMock.getButton().nextDeadline());
+}
+
+unittest(reset_keeps_debouncer_and_clears_samples) {
+    IntegratorDebouncer<2> debouncer;
+    testMock.getButton().setDebouncer(&debouncer);
+    debouncer.update(true, 0);
+
+    testMock.getButton().reset();
+    assertTrue(debouncer.isSettled());
+}
+
+unittest_main()
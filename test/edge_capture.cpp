@@ -0,0 +1,124 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+ListenerMock testMock = ListenerMock(digitalButton);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    testMock.resetState();
+    state->reset();
+}
+
+unittest(add_rejects_buttons_over_capacity) {
+    EdgeCapture<4, 1> edges;
+
+    assertEqual(0, edges.add(digitalButton));
+    assertEqual(-1, edges.add(digitalButton));
+}
+
+unittest(short_click_between_slow_ticks_is_not_lost) {
+    EdgeCapture<4, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    // press and release captured by interrupts while loop() is busy
+    edges.capture(source, true, 10);
+    edges.capture(source, false, 10 + DEFAULT_DEBOUNCE_TICKS_MS + 20);
+    assertEqual(2, edges.getPendingCount());
+
+    // loop() gets to tick long after the click window
+    edges.tick(1000);
+
+    assertEqual(0, edges.getPendingCount());
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(0, testMock.getLongPressStartEventsReceivedCount());
+}
+
+unittest(bounce_shorter_than_debounce_is_ignored) {
+    EdgeCapture<8, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    edges.capture(source, true, 10);
+    edges.capture(source, false, 12);
+    edges.capture(source, true, 14);
+    edges.capture(source, false, 16);
+    edges.tick(1000);
+
+    assertEqual(0, testMock.getPressEventsReceivedCount());
+    assertEqual(0, testMock.getClickEventsReceivedCount());
+}
+
+unittest(long_press_is_detected_from_held_level) {
+    EdgeCapture<4, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    edges.capture(source, true, 10);
+    edges.tick(20);
+    edges.tick(DEFAULT_LONG_PRESS_TICKS_MS + 20);
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getLongPressStartEventsReceivedCount());
+    assertEqual(true, digitalButton.isLongPressed());
+}
+
+unittest(overflowing_edges_are_counted) {
+    EdgeCapture<4, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    for (uint8_t i = 0; i < 6; i++)
+        edges.capture(source, i % 2 == 0, i);
+
+    assertEqual(4, edges.getPendingCount());
+    assertEqual(2, edges.getOverflowCount());
+}
+
+unittest(capture_uses_millis_by_default) {
+    EdgeCapture<4, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    state->micros = 5000;
+    edges.capture(source, true);
+    state->micros = (5 + DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    edges.tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+}
+
+unittest(first_edge_after_half_of_clock_range_is_not_clamped) {
+    // 32-bit millis() after 24.8 days of uptime
+    setClock(nullptr, 32);
+    EdgeCapture<4, 1> edges;
+    int16_t source = edges.add(digitalButton);
+
+    edges.capture(source, true, 0x80000000UL + 10);
+    edges.capture(source, false, 0x80000000UL + 10 + DEFAULT_DEBOUNCE_TICKS_MS + 20);
+    edges.tick(0x80000000UL + 1000);
+    setClock(nullptr);
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+}
+
+unittest_main()
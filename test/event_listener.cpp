@@ -0,0 +1,133 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    testMock.resetState();
+    state->reset();
+}
+
+unittest(press_event_carries_button_id_time_and_duration) {
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    state->micros = 100 * 1000;
+    digitalButton.tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (100 + DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+    assertEqual(INPUT_PIN, testMock.getLastEvent().buttonId);
+    assertEqual(100 + DEFAULT_DEBOUNCE_TICKS_MS + 1, testMock.getLastEvent().time);
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 1, testMock.getLastEvent().pressDuration);
+    assertEqual(0, testMock.getLastEvent().clickCount);
+}
+
+unittest(click_event_carries_click_count_and_press_duration) {
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = 80 * 1000;
+    digitalButton.tick();
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::RELEASE));
+    assertEqual(80, testMock.getLastEvent().pressDuration);
+
+    // wait for click timeout
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(3, testMock.getAllEventsReceivedCount());
+    assertEqual(1, testMock.getLastEvent().clickCount);
+    assertEqual(80, testMock.getLastEvent().pressDuration);
+    assertEqual(DEFAULT_CLICK_TICKS_MS + 1, testMock.getLastEvent().time);
+}
+
+unittest(double_click_event_carries_click_count) {
+    // first click
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = 2 * DEFAULT_DEBOUNCE_TICKS_MS * 1000;
+    digitalButton.tick();
+
+    // second click
+    state->digitalPin[INPUT_PIN] = LOW;
+    state->micros = (3 * DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (4 * DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    digitalButton.tick();
+
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(2, testMock.getLastEvent().clickCount);
+}
+
+unittest(click_is_reported_on_release_if_listener_ignores_double_click) {
+    testMock.setDoubleClickObserved(false);
+
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+}
+
+unittest(long_press_events_are_reported) {
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+    assertEqual(DEFAULT_LONG_PRESS_TICKS_MS + 1, testMock.getLastEvent().pressDuration);
+
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = 700 * 1000;
+    digitalButton.tick();
+    digitalButton.tick();
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+    assertEqual(700, testMock.getLastEvent().pressDuration);
+}
+
+unittest_main()
@@ -0,0 +1,159 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN_1 = 10;
+constexpr static byte INPUT_PIN_2 = 11;
+
+DigitalButton digitalButton1 = DigitalButton(INPUT_PIN_1, true);
+DigitalButton digitalButton2 = DigitalButton(INPUT_PIN_2, true);
+
+/*
+ * Press and release a button between two ticks, so that it produces a click.
+ */
+static void click(Button &button, unsigned long time) {
+    button.tick(time, true);
+    button.tick(time + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    button.tick(time + 100, false);
+}
+
+unittest_setup() {
+    digitalButton1.reset();
+    digitalButton2.reset();
+}
+
+unittest(empty_queue_has_no_event) {
+    EventQueue<4> queue;
+    ButtonEvent event = {};
+
+    assertFalse(queue.pollEvent(event));
+    assertEqual(0, queue.getPendingCount());
+}
+
+unittest(events_are_polled_in_order) {
+    EventQueue<8> queue;
+    queue.setObserved(ButtonEventType::DOUBLE_CLICK, false);
+    digitalButton1.setEventListener(&queue);
+
+    click(digitalButton1, 1000);
+    assertEqual(3, queue.getPendingCount());
+
+    ButtonEvent event = {};
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::PRESS), static_cast<int>(event.type));
+    assertEqual(INPUT_PIN_1, event.buttonId);
+    assertEqual(1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, event.time);
+
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::RELEASE), static_cast<int>(event.type));
+
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::CLICK), static_cast<int>(event.type));
+    assertEqual(100, event.pressDuration);
+
+    assertFalse(queue.pollEvent(event));
+    assertEqual(0, queue.getPendingCount());
+}
+
+unittest(observed_double_click_delays_click) {
+    EventQueue<8> queue;
+    digitalButton1.setEventListener(&queue);
+
+    click(digitalButton1, 1000);
+    assertEqual(2, queue.getPendingCount());
+
+    digitalButton1.tick(1000 + DEFAULT_CLICK_TICKS_MS + 1, false);
+    assertEqual(3, queue.getPendingCount());
+}
+
+unittest(unobserved_events_are_not_queued) {
+    EventQueue<8> queue;
+    queue.setObserved(ButtonEventType::DOUBLE_CLICK, false);
+    queue.setObserved(ButtonEventType::PRESS, false);
+    queue.setObserved(ButtonEventType::RELEASE, false);
+    digitalButton1.setEventListener(&queue);
+
+    click(digitalButton1, 1000);
+
+    ButtonEvent event = {};
+    assertEqual(1, queue.getPendingCount());
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::CLICK), static_cast<int>(event.type));
+}
+
+unittest(group_shares_a_queue) {
+    EventQueue<8> queue;
+    queue.setObserved(ButtonEventType::DOUBLE_CLICK, false);
+    queue.setObserved(ButtonEventType::PRESS, false);
+    queue.setObserved(ButtonEventType::RELEASE, false);
+    ButtonGroup<2> group;
+    group.add(digitalButton1);
+    group.add(digitalButton2);
+    group.setEventListener(&queue);
+
+    click(digitalButton2, 1000);
+    click(digitalButton1, 2000);
+
+    ButtonEvent event = {};
+    assertTrue(queue.pollEvent(event));
+    assertEqual(INPUT_PIN_2, event.buttonId);
+    assertTrue(queue.pollEvent(event));
+    assertEqual(INPUT_PIN_1, event.buttonId);
+}
+
+unittest(full_queue_drops_and_counts_events) {
+    EventQueue<2> queue;
+    queue.setObserved(ButtonEventType::DOUBLE_CLICK, false);
+    digitalButton1.setEventListener(&queue);
+
+    click(digitalButton1, 1000);
+    click(digitalButton1, 2000);
+
+    assertEqual(2, queue.getPendingCount());
+    assertEqual(4, queue.getOverflowCount());
+
+    // the oldest events are kept
+    ButtonEvent event = {};
+    assertTrue(queue.pollEvent(event));
+    assertEqual(static_cast<int>(ButtonEventType::PRESS), static_cast<int>(event.type));
+    assertEqual(1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, event.time);
+
+    queue.clear();
+    assertEqual(0, queue.getPendingCount());
+    assertEqual(0, queue.getOverflowCount());
+}
+
+unittest(queue_wraps_around) {
+    EventQueue<4> queue;
+    queue.setObserved(ButtonEventType::DOUBLE_CLICK, false);
+    digitalButton1.setEventListener(&queue);
+
+    // 100 clicks of 3 events each pass through a queue of 4, indices wrap several times
+    ButtonEvent event = {};
+    for (unsigned long i = 0; i < 100; i++) {
+        click(digitalButton1, 1000 + i * 1000);
+        for (uint8_t j = 0; j < 3; j++)
+            assertTrue(queue.pollEvent(event));
+        assertEqual(static_cast<int>(ButtonEventType::CLICK), static_cast<int>(event.type));
+    }
+    assertEqual(0, queue.getOverflowCount());
+}
+
+unittest_main()
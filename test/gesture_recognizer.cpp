@@ -0,0 +1,278 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN_1 = 10;
+constexpr static byte INPUT_PIN_2 = 11;
+constexpr static byte INPUT_PIN_3 = 12;
+constexpr static byte INPUT_PIN_4 = 13;
+
+DigitalButton digitalButton1 = DigitalButton(INPUT_PIN_1, true);
+DigitalButton digitalButton2 = DigitalButton(INPUT_PIN_2, true);
+DigitalButton digitalButton3 = DigitalButton(INPUT_PIN_3, true);
+DigitalButton digitalButton4 = DigitalButton(INPUT_PIN_4, true);
+ListenerMock legacyListener = ListenerMock(digitalButton4);
+
+/*
+ * Gestures recognized so far, in order.
+ */
+uint8_t recognized[8];
+uint8_t recognizedCount;
+
+static void onGesture(uint8_t gesture, void *context) {
+    if (recognizedCount < sizeof(recognized))
+        recognized[recognizedCount] = gesture;
+    recognizedCount++;
+}
+
+/*
+ * Press a button at <code>time</code> and release it after <code>duration</code> milliseconds.
+ * @return time of the release.
+ */
+static unsigned long press(Button &button, unsigned long time, unsigned long duration) {
+    button.tick(time, true);
+    button.tick(time + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    button.tick(time + duration, true);
+    button.tick(time + duration + 1, false);
+    return time + duration + 1;
+}
+
+static unsigned long shortPress(Button &button, unsigned long time) {
+    return press(button, time, 100);
+}
+
+static unsigned long longPress(Button &button, unsigned long time) {
+    return press(button, time, DEFAULT_LONG_PRESS_TICKS_MS + 100);
+}
+
+unittest_setup() {
+    digitalButton1.reset();
+    digitalButton2.reset();
+    digitalButton3.reset();
+    digitalButton4.reset();
+    legacyListener.resetState();
+    recognizedCount = 0;
+}
+
+unittest(recognizer_rejects_gestures_over_capacity) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[MAX_GESTURE_STEPS + 1] = {};
+    GestureStep twoButtons[] = {{INPUT_PIN_1, GestureToken::SHORT}, {INPUT_PIN_2, GestureToken::SHORT}};
+
+    assertFalse(recognizer.add(steps, 0));
+    assertFalse(recognizer.add(steps, MAX_GESTURE_STEPS + 1));
+    assertFalse(recognizer.add(twoButtons, 2));
+    assertTrue(recognizer.add(steps, MAX_GESTURE_STEPS));
+    assertFalse(recognizer.add(steps, 1));
+    assertEqual(1, recognizer.size());
+}
+
+unittest(long_short_short_is_recognized_on_one_button) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[] = {
+            {INPUT_PIN_1, GestureToken::LONG},
+            {INPUT_PIN_1, GestureToken::SHORT},
+            {INPUT_PIN_1, GestureToken::SHORT}
+    };
+    recognizer.add(steps, 3);
+    recognizer.setCallback(onGesture);
+    digitalButton1.setEventListener(&recognizer);
+
+    unsigned long time = longPress(digitalButton1, 1000);
+    time = shortPress(digitalButton1, time + 100);
+    assertEqual(0, recognizedCount);
+
+    // clicks are reported right after release, no double-click is detected in between
+    shortPress(digitalButton1, time + 100);
+    assertEqual(1, recognizedCount);
+    assertEqual(0, recognized[0]);
+}
+
+unittest(wrong_token_breaks_gesture) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[] = {{INPUT_PIN_1, GestureToken::LONG}, {INPUT_PIN_1, GestureToken::SHORT}};
+    recognizer.add(steps, 2);
+    recognizer.setCallback(onGesture);
+    digitalButton1.setEventListener(&recognizer);
+
+    unsigned long time = shortPress(digitalButton1, 1000);
+    time = shortPress(digitalButton1, time + 100);
+    assertEqual(0, recognizedCount);
+
+    // long press starts the gesture anew
+    time = longPress(digitalButton1, time + 100);
+    time = longPress(digitalButton1, time + 100);
+    shortPress(digitalButton1, time + 100);
+    assertEqual(1, recognizedCount);
+}
+
+unittest(pattern_across_buttons_survives_partial_match) {
+    GestureRecognizer<3> recognizer;
+    GestureStep steps[] = {
+            {INPUT_PIN_1, GestureToken::PRESS},
+            {INPUT_PIN_2, GestureToken::PRESS},
+            {INPUT_PIN_1, GestureToken::PRESS}
+    };
+    recognizer.add(steps, 3);
+    recognizer.setCallback(onGesture);
+    digitalButton1.setEventListener(&recognizer);
+    digitalButton2.setEventListener(&recognizer);
+
+    // A, A, B, A: the second A starts the gesture again
+    unsigned long time = shortPress(digitalButton1, 1000);
+    time = longPress(digitalButton1, time + 100);
+    time = shortPress(digitalButton2, time + 100);
+    assertEqual(0, recognizedCount);
+    longPress(digitalButton1, time + 100);
+    assertEqual(1, recognizedCount);
+}
+
+unittest(press_of_other_button_breaks_gesture) {
+    GestureRecognizer<2> recognizer;
+    GestureStep steps[] = {{INPUT_PIN_1, GestureToken::SHORT}, {INPUT_PIN_1, GestureToken::SHORT}};
+    recognizer.add(steps, 2);
+    recognizer.setCallback(onGesture);
+    digitalButton1.setEventListener(&recognizer);
+    digitalButton3.setEventListener(&recognizer);
+
+    unsigned long time = shortPress(digitalButton1, 1000);
+    time = shortPress(digitalButton3, time + 100);
+    shortPress(digitalButton1, time + 100);
+    assertEqual(0, recognizedCount);
+}
+
+unittest(slow_presses_time_out) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[] = {{INPUT_PIN_1, GestureToken::SHORT}, {INPUT_PIN_1, GestureToken::SHORT}};
+    recognizer.add(steps, 2);
+    recognizer.setCallback(onGesture);
+    recognizer.setTimeoutTicks(500);
+    digitalButton1.setEventListener(&recognizer);
+
+    // releases are more than 500 ms apart
+    unsigned long time = shortPress(digitalButton1, 1000);
+    time = shortPress(digitalButton1, time + 410);
+    assertEqual(0, recognizedCount);
+
+    shortPress(digitalButton1, time + 300);
+    assertEqual(1, recognizedCount);
+}
+
+unittest(first_added_gesture_wins_and_automaton_starts_over) {
+    GestureRecognizer<2> recognizer;
+    GestureStep ab[] = {{INPUT_PIN_1, GestureToken::SHORT}, {INPUT_PIN_2, GestureToken::SHORT}};
+    GestureStep b[] = {{INPUT_PIN_2, GestureToken::SHORT}};
+    GestureStep bb[] = {{INPUT_PIN_2, GestureToken::SHORT}, {INPUT_PIN_2, GestureToken::SHORT}};
+    recognizer.add(ab, 2);
+    recognizer.add(bb, 2);
+    recognizer.add(b, 1);
+    recognizer.setCallback(onGesture);
+    digitalButton1.setEventListener(&recognizer);
+    digitalButton2.setEventListener(&recognizer);
+
+    unsigned long time = shortPress(digitalButton1, 1000);
+    time = shortPress(digitalButton2, time + 100);
+    time = shortPress(digitalButton2, time + 100);
+
+    // B completes both "A, B" and "B", then the last B is "B" again, not "B, B"
+    assertEqual(2, recognizedCount);
+    assertEqual(0, recognized[0]);
+    assertEqual(2, recognized[1]);
+
+    recognizer.reset();
+    shortPress(digitalButton2, time + 100);
+    assertEqual(3, recognizedCount);
+    assertEqual(2, recognized[2]);
+}
+
+unittest(buttons_colliding_in_index_are_told_apart) {
+    // all IDs hash into the same slot of the index
+    DigitalButton button18 = DigitalButton(18, true);
+    DigitalButton button26 = DigitalButton(26, true);
+    DigitalButton button34 = DigitalButton(34, true);
+    GestureRecognizer<3> recognizer;
+    GestureStep steps[] = {{18, GestureToken::SHORT}, {26, GestureToken::LONG}, {INPUT_PIN_1, GestureToken::SHORT}};
+    assertTrue(recognizer.add(steps, 3));
+    recognizer.setCallback(onGesture);
+    button18.setEventListener(&recognizer);
+    button26.setEventListener(&recognizer);
+    button34.setEventListener(&recognizer);
+    digitalButton1.setEventListener(&recognizer);
+
+    // unknown button probes to an empty slot and breaks the gesture
+    unsigned long time = shortPress(button18, 1000);
+    time = longPress(button26, time + 100);
+    time = shortPress(button34, time + 100);
+    time = shortPress(digitalButton1, time + 100);
+    assertEqual(0, recognizedCount);
+
+    time = shortPress(button18, time + 100);
+    time = longPress(button26, time + 100);
+    shortPress(digitalButton1, time + 100);
+    assertEqual(1, recognizedCount);
+}
+
+unittest(merged_double_click_is_fed_as_two_clicks) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[] = {
+            {INPUT_PIN_4, GestureToken::SHORT},
+            {INPUT_PIN_4, GestureToken::SHORT},
+            {INPUT_PIN_4, GestureToken::LONG}
+    };
+    recognizer.add(steps, 3);
+    recognizer.setCallback(onGesture);
+    digitalButton4.setEventListener(&recognizer);
+
+    // legacy double-click listener makes the button merge two quick clicks
+    unsigned long time = shortPress(digitalButton4, 1000);
+    time = shortPress(digitalButton4, time + 100);
+    assertEqual(1, legacyListener.getDoubleClickEventsReceivedCount());
+    assertEqual(0, recognizedCount);
+
+    longPress(digitalButton4, time + 400);
+    assertEqual(1, recognizedCount);
+    assertEqual(0, recognized[0]);
+}
+
+unittest(speculative_click_is_not_fed_twice) {
+    GestureRecognizer<1> recognizer;
+    GestureStep steps[] = {
+            {INPUT_PIN_4, GestureToken::SHORT},
+            {INPUT_PIN_4, GestureToken::SHORT},
+            {INPUT_PIN_4, GestureToken::SHORT}
+    };
+    recognizer.add(steps, 3);
+    recognizer.setCallback(onGesture);
+    digitalButton4.setSpeculativeClick(true);
+    digitalButton4.setEventListener(&recognizer);
+
+    // click, then click cancelled and double-click on the second release
+    unsigned long time = shortPress(digitalButton4, 1000);
+    time = shortPress(digitalButton4, time + 100);
+    assertEqual(1, legacyListener.getClickCancelledEventsReceivedCount());
+    assertEqual(1, legacyListener.getDoubleClickEventsReceivedCount());
+    assertEqual(0, recognizedCount);
+
+    shortPress(digitalButton4, time + 100);
+    assertEqual(1, recognizedCount);
+}
+
+unittest_main()
@@ -0,0 +1,169 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+LatencyStats stats;
+
+unittest_setup() {
+    stats.reset();
+}
+
+unittest(stats_are_empty_after_reset) {
+    stats.record(ButtonEventType::CLICK, 100, 10);
+    stats.reset();
+
+    assertEqual(0, stats.getCount(ButtonEventType::CLICK));
+    assertEqual(0, stats.getMinLatency(ButtonEventType::CLICK));
+    assertEqual(0, stats.getMaxLatency(ButtonEventType::CLICK));
+    assertEqual(0, stats.getMeanLatency(ButtonEventType::CLICK));
+    assertEqual(0, stats.getMeanTickInterval(ButtonEventType::CLICK));
+    for (uint8_t i = 0; i < LatencyStats::HISTOGRAM_BUCKETS; i++)
+        assertEqual(0, stats.getHistogram(ButtonEventType::CLICK, i));
+}
+
+unittest(stats_are_kept_per_event_type) {
+    stats.record(ButtonEventType::PRESS, 51, 1);
+    stats.record(ButtonEventType::PRESS, 60, 10);
+    stats.record(ButtonEventType::PRESS, 90, 40);
+    stats.record(ButtonEventType::CLICK, 300, 5);
+
+    assertEqual(3, stats.getCount(ButtonEventType::PRESS));
+    assertEqual(51, stats.getMinLatency(ButtonEventType::PRESS));
+    assertEqual(90, stats.getMaxLatency(ButtonEventType::PRESS));
+    assertEqual(67, stats.getMeanLatency(ButtonEventType::PRESS));
+    assertEqual(40, stats.getMaxTickInterval(ButtonEventType::PRESS));
+    assertEqual(17, stats.getMeanTickInterval(ButtonEventType::PRESS));
+
+    assertEqual(1, stats.getCount(ButtonEventType::CLICK));
+    assertEqual(300, stats.getMinLatency(ButtonEventType::CLICK));
+    assertEqual(0, stats.getCount(ButtonEventType::RELEASE));
+}
+
+unittest(histogram_buckets_are_log_scale) {
+    const uint16_t latencies[] = {0, 7, 8, 15, 16, 100, 511, 512, 60000};
+    for (uint16_t latency : latencies)
+        stats.record(ButtonEventType::RELEASE, latency, 0);
+
+    assertEqual(2, stats.getHistogram(ButtonEventType::RELEASE, 0));
+    assertEqual(2, stats.getHistogram(ButtonEventType::RELEASE, 1));
+    assertEqual(1, stats.getHistogram(ButtonEventType::RELEASE, 2));
+    assertEqual(0, stats.getHistogram(ButtonEventType::RELEASE, 3));
+    assertEqual(1, stats.getHistogram(ButtonEventType::RELEASE, 4));
+    assertEqual(0, stats.getHistogram(ButtonEventType::RELEASE, 5));
+    assertEqual(1, stats.getHistogram(ButtonEventType::RELEASE, 6));
+    assertEqual(2, stats.getHistogram(ButtonEventType::RELEASE, 7));
+    assertEqual(0, stats.getHistogram(ButtonEventType::RELEASE, LatencyStats::HISTOGRAM_BUCKETS));
+
+    assertEqual(0, LatencyStats::getBucketLowerBound(0));
+    assertEqual(8, LatencyStats::getBucketLowerBound(1));
+    assertEqual(16, LatencyStats::getBucketLowerBound(2));
+    assertEqual(512, LatencyStats::getBucketLowerBound(7));
+}
+
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+
+/*
+ * Tick the button every <code>period</code> milliseconds in [from, to) with a constant input.
+ */
+static void tickRange(unsigned long from, unsigned long to, unsigned long period, bool pressed) {
+    for (unsigned long now = from; now < to; now += period)
+        digitalButton.tick(now, pressed);
+}
+
+static void setUpButton(bool doubleClickObserved) {
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    digitalButton.setLatencyStats(&stats);
+    testMock.resetState();
+    testMock.setDoubleClickObserved(doubleClickObserved);
+}
+
+unittest(press_latency_is_measured_from_first_bounce) {
+    setUpButton(false);
+    tickRange(980, 1000, 10, false);
+
+    // bounce at 1005 restarts debounce interval, latency still counts from 1000
+    tickRange(1000, 1005, 1, true);
+    tickRange(1005, 1010, 1, false);
+    tickRange(1010, 1100, 1, true);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+    assertEqual(1, stats.getCount(ButtonEventType::PRESS));
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 11, stats.getMaxLatency(ButtonEventType::PRESS));
+    assertEqual(10, stats.getMaxTickInterval(ButtonEventType::PRESS));
+    assertEqual(1, stats.getHistogram(ButtonEventType::PRESS, 3));
+}
+
+unittest(click_latency_includes_click_interval) {
+    setUpButton(true);
+    tickRange(980, 1000, 10, false);
+    tickRange(1000, 1100, 10, true);
+    tickRange(1100, 1400, 10, false);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 10, stats.getMaxLatency(ButtonEventType::PRESS));
+    assertEqual(0, stats.getMaxLatency(ButtonEventType::RELEASE));
+    // click fires once click interval since the press elapses, 100 ms of it was spent pressed
+    assertEqual(DEFAULT_CLICK_TICKS_MS + 10 - 100, stats.getMaxLatency(ButtonEventType::CLICK));
+}
+
+unittest(double_click_latency_is_measured_from_second_release) {
+    setUpButton(true);
+    tickRange(980, 1000, 10, false);
+    tickRange(1000, 1100, 10, true);
+    tickRange(1100, 1160, 10, false);
+    tickRange(1160, 1260, 10, true);
+    tickRange(1260, 1300, 10, false);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(1, stats.getCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(0, stats.getMaxLatency(ButtonEventType::DOUBLE_CLICK));
+}
+
+unittest(glitch_on_idle_input_does_not_delay_next_press) {
+    setUpButton(false);
+    tickRange(980, 1000, 10, false);
+    tickRange(1000, 1001, 1, true);
+    tickRange(1001, 1200, 1, false);
+    assertEqual(0, testMock.getAllEventsReceivedCount());
+
+    tickRange(1200, 1300, 10, true);
+
+    assertEqual(1, stats.getCount(ButtonEventType::PRESS));
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 10, stats.getMaxLatency(ButtonEventType::PRESS));
+    assertEqual(1, stats.getMaxTickInterval(ButtonEventType::PRESS));
+}
+
+unittest(lockout_press_has_no_latency) {
+    setUpButton(false);
+    digitalButton.setLockoutDebounce(true);
+    tickRange(980, 1000, 10, false);
+    tickRange(1000, 1100, 10, true);
+
+    assertEqual(1, stats.getCount(ButtonEventType::PRESS));
+    assertEqual(0, stats.getMaxLatency(ButtonEventType::PRESS));
+}
+#endif
+
+unittest_main()
@@ -0,0 +1,133 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+/*
+ * Per-button RAM budget. Besides the vtable pointer, four listener pointers, a pointer to a callback table,
+ * a debouncer pointer and a pointer to a shared timing profile, a button keeps its pin, two 16-bit timestamps
+ * and three bytes of packed state, flags, click and repeat counts. Timing set by the per-button setters is stored
+ * in place of the profile pointer, which is no smaller on the host.
+ */
+constexpr static size_t BUTTON_STATE_BYTES = 1 + 4 + 3;
+
+/*
+ * Latency instrumentation adds a pointer to statistics, four 16-bit timestamps and three flags.
+ */
+#ifdef OBJECT_BUTTON_LATENCY_STATS
+constexpr static size_t LATENCY_STATS_BYTES = sizeof(void*) + 8 + 3 + alignof(void*);
+#else
+constexpr static size_t LATENCY_STATS_BYTES = 0;
+#endif
+
+constexpr static size_t BUTTON_BUDGET_BYTES =
+        (8 * sizeof(void*) + BUTTON_STATE_BYTES + alignof(void*) - 1) / alignof(void*) * alignof(void*)
+        + alignof(void*) + LATENCY_STATS_BYTES;
+
+/*
+ * Layout of a button before timestamps were made relative and flags packed.
+ */
+struct UnpackedButtonLayout {
+    void *vtable;
+    uint8_t pin;
+    void *listeners[4];
+    uint8_t debounceTicks;
+    uint16_t clickTicks;
+    uint16_t longPressTicks;
+    bool isLongButtonPress;
+    bool buttonPressNotified;
+    bool speculativeClick;
+    int state;
+    unsigned long buttonPressedTime;
+    unsigned long buttonReleasedTime;
+};
+
+static_assert(sizeof(ButtonTiming) <= 6, "Timing profile does not fit into 6 bytes");
+static_assert(sizeof(ButtonTiming) <= sizeof(void*), "Own timing of a button does not fit in place of a pointer");
+static_assert(sizeof(Button) <= BUTTON_BUDGET_BYTES, "Button exceeds its RAM budget");
+static_assert(sizeof(Button) - LATENCY_STATS_BYTES < sizeof(UnpackedButtonLayout), "Button is not smaller than the unpacked layout");
+static_assert(sizeof(DigitalButton) - sizeof(Button) <= alignof(void*), "DigitalButton adds more than a pin level");
+static_assert(sizeof(AnalogButton) - sizeof(Button) <= 5 + alignof(void*), "AnalogButton adds more than ID, voltage and margin");
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    testMock.resetState();
+    testMock.setDoubleClickObserved(false);
+    state->reset();
+}
+
+unittest(click_is_detected_across_16_bit_timestamp_overflow) {
+    // press button right before lower 16 bits of millis() overflow
+    state->micros = 65530UL * 1000;
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+
+    state->micros = (65530UL + DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    digitalButton.tick();
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+    // release button
+    state->micros = (65530UL + DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    state->digitalPin[INPUT_PIN] = HIGH;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 10, testMock.getLastEvent().pressDuration);
+}
+
+unittest(long_press_duration_saturates) {
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+
+    // hold button for 70 seconds, ticking at every deadline
+    for (unsigned long now = 0; now <= 70000UL; now += 1000) {
+        state->micros = now * 1000;
+        digitalButton.tick();
+    }
+
+    state->digitalPin[INPUT_PIN] = HIGH;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+    assertEqual(MAX_PRESS_DURATION_MS, testMock.getLastEvent().pressDuration);
+}
+
+unittest(long_press_duration_is_measured_below_saturation) {
+    state->digitalPin[INPUT_PIN] = LOW;
+    digitalButton.tick();
+
+    state->micros = 30000UL * 1000;
+    digitalButton.tick();
+
+    state->digitalPin[INPUT_PIN] = HIGH;
+    digitalButton.tick();
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+    assertEqual(30000, testMock.getLastEvent().pressDuration);
+}
+
+unittest_main()
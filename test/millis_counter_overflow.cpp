@@ -16,34 +16,257 @@
 
 #include <ArduinoUnitTests.h>
 #include "../src/ObjectButton.h"
-#include "mocks/ListenerMock.h"
+#include "mocks/EventListenerMock.h"
 using namespace jsc;
 
 constexpr static byte INPUT_PIN = 10;
 
-GodmodeState* state = GODMODE();
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
 
-unittest_setup() {
-    state->reset();
+/*
+ * Every scenario starts at each of these points. They sweep the 32-bit millis() overflow from both sides,
+ * the 16-bit timestamp overflow, and the time right after boot.
+ */
+const unsigned long START_TIMES[] = {
+        0, 1, 2,
+        65536UL - 1000, 65536UL - 501, 65536UL - 251, 65536UL - 51, 65536UL - 1,
+        0xFFFFFFFFUL - 1000, 0xFFFFFFFFUL - 500, 0xFFFFFFFFUL - 250, 0xFFFFFFFFUL - 100,
+        0xFFFFFFFFUL - 51, 0xFFFFFFFFUL - 50, 0xFFFFFFFFUL - 1, 0xFFFFFFFFUL
+};
+
+unsigned long start = 0;
+
+/*
+ * Emulate millis() of a 32-bit MCU, which wraps to zero after 49.7 days.
+ */
+static unsigned long at(unsigned long offset) {
+    return static_cast<uint32_t>(start + offset);
+}
+
+/*
+ * Tick the button every millisecond in [from, to] relative to the scenario start.
+ */
+static void hold(unsigned long from, unsigned long to, bool pressed) {
+    for (unsigned long offset = from; offset <= to; offset++)
+        digitalButton.tick(at(offset), pressed);
+}
+
+/*
+ * Keep the button pressed in [from, to] relative to the scenario start, ticking it only when it asks for it.
+ */
+static void holdByDeadline(unsigned long from, unsigned long to) {
+    unsigned long offset = from;
+    digitalButton.tick(at(offset), true);
+    while (offset < to) {
+        unsigned long deadline = digitalButton.nextDeadline(at(offset));
+        offset = deadline == NO_DEADLINE || offset + deadline > to ? to : offset + (deadline > 0 ? deadline : 1);
+        digitalButton.tick(at(offset), true);
+    }
+}
+
+static void begin(unsigned long startTime, bool doubleClickObserved) {
+    start = startTime;
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    testMock.resetState();
+    testMock.setDoubleClickObserved(doubleClickObserved);
+}
+
+unittest(press_fires_after_debounce_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, false);
+
+        hold(0, DEFAULT_DEBOUNCE_TICKS_MS, true);
+        assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+        hold(DEFAULT_DEBOUNCE_TICKS_MS + 1, DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+        assertEqual(at(DEFAULT_DEBOUNCE_TICKS_MS + 1), testMock.getLastEvent().time);
+    }
+}
+
+unittest(short_press_is_a_bounce_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, false);
+
+        hold(0, DEFAULT_DEBOUNCE_TICKS_MS - 1, true);
+        hold(DEFAULT_DEBOUNCE_TICKS_MS, 1000, false);
+        assertEqual(0, testMock.getAllEventsReceivedCount());
+    }
+}
+
+unittest(release_and_click_fire_on_release_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, false);
+
+        hold(0, 99, true);
+        hold(100, 100, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::RELEASE));
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+        assertEqual(at(100), testMock.getLastEvent().time);
+        assertEqual(100, testMock.getLastEvent().pressDuration);
+    }
+}
+
+unittest(click_fires_after_click_interval_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
+
+        hold(0, 99, true);
+        hold(100, DEFAULT_CLICK_TICKS_MS, false);
+        assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+
+        hold(DEFAULT_CLICK_TICKS_MS + 1, DEFAULT_CLICK_TICKS_MS + 1, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+        assertEqual(at(DEFAULT_CLICK_TICKS_MS + 1), testMock.getLastEvent().time);
+        assertEqual(100, testMock.getLastEvent().pressDuration);
+    }
+}
+
+unittest(double_click_fires_on_second_release_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
+
+        hold(0, 99, true);
+        hold(100, 199, false);
+        hold(200, 279, true);
+        hold(280, 280, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+        assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+        assertEqual(at(280), testMock.getLastEvent().time);
+        assertEqual(80, testMock.getLastEvent().pressDuration);
+    }
+}
+
+unittest(click_is_cancelled_by_double_click_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
+        digitalButton.setSpeculativeClick(true);
+
+        hold(0, 99, true);
+        hold(100, 100, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+
+        hold(101, 199, false);
+        hold(200, 279, true);
+        hold(280, 280, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK_CANCELLED));
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    }
+}
+
+unittest(long_press_starts_after_interval_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, false);
+
+        hold(0, DEFAULT_LONG_PRESS_TICKS_MS, true);
+        assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+
+        hold(DEFAULT_LONG_PRESS_TICKS_MS + 1, 1000, true);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+
+        hold(1001, 1001, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+        assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+        assertEqual(1001, testMock.getLastEvent().pressDuration);
+    }
+}
+
+unittest(lockout_ignores_bounces_across_overflow) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, false);
+        digitalButton.setLockoutDebounce(true);
+
+        // first edge fires right away, bounces within debounce interval are ignored
+        hold(0, 0, true);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+        hold(1, 10, false);
+        hold(11, 99, true);
+        hold(100, 100, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::RELEASE));
+
+        // press is blocked until release lockout expires
+        hold(101, 110, true);
+        hold(111, 100 + DEFAULT_DEBOUNCE_TICKS_MS, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+
+        hold(101 + DEFAULT_DEBOUNCE_TICKS_MS, 101 + DEFAULT_DEBOUNCE_TICKS_MS, true);
+        assertEqual(2, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+    }
+}
+
+unittest(long_press_ticked_by_deadline_saturates) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
+
+        holdByDeadline(0, 70000UL);
+
+        hold(70001UL, 70001UL, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+        hold(70002UL, 70002UL, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+        assertEqual(MAX_PRESS_DURATION_MS, testMock.getLastEvent().pressDuration);
+    }
+}
+
+unittest(second_press_of_double_click_saturates) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
+
+        hold(0, 99, true);
+        hold(100, 199, false);
+
+        holdByDeadline(200, 70000UL);
+
+        hold(70001UL, 70001UL, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+        assertEqual(MAX_PRESS_DURATION_MS, testMock.getLastEvent().pressDuration);
+    }
 }
 
-unittest(millis_counter_overflow) {
-        DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
-        ListenerMock testMock = ListenerMock(digitalButton);
+unittest(release_after_timestamp_wrap_is_not_a_bounce) {
+    // 65557 ms hold leaves a 21 ms delta in 16 bits, inside the debounce interval
+    const unsigned long releaseTime = 65536UL + 21;
+
+    for (unsigned long startTime : START_TIMES) {
+        for (int mode = 0; mode < 3; mode++) {
+            begin(startTime, mode == 1);
+            digitalButton.setLockoutDebounce(mode == 2);
 
-        // Set millis() one millisecond before counter overflow
-        state->micros = -1000;
+            holdByDeadline(0, releaseTime - 1);
+            hold(releaseTime, releaseTime + DEFAULT_CLICK_TICKS_MS + 1, false);
+            assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::RELEASE));
+            assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+            assertEqual(MAX_PRESS_DURATION_MS, testMock.getLastEvent().pressDuration);
+
+            // next press starts clean
+            unsigned long next = releaseTime + 1000;
+            hold(next, next + 1000, true);
+            assertEqual(2, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+            assertEqual(2, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+            assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+
+            hold(next + 1001, next + 1001 + DEFAULT_CLICK_TICKS_MS + 1, false);
+            assertEqual(2, testMock.getEventsReceivedCount(ButtonEventType::RELEASE));
+            assertEqual(2, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_END));
+            assertEqual(1001, testMock.getLastEvent().pressDuration);
+        }
+    }
+}
 
-        // press button
-        state->digitalPin[INPUT_PIN] = LOW;
-        testMock.getButton().tick();
+unittest(second_press_released_after_timestamp_wrap) {
+    for (unsigned long startTime : START_TIMES) {
+        begin(startTime, true);
 
-        // Set millis() one millisecond after counter overflow
-        state->micros = 1000;
-        testMock.getButton().tick();
+        hold(0, 99, true);
+        hold(100, 199, false);
+        holdByDeadline(200, 200 + 65536UL + 20);
 
-        // validate click event -- note: false positive
-        assertEqual(1, testMock.getPressEventsReceivedCount());
+        hold(200 + 65536UL + 21, 200 + 65536UL + 21, false);
+        assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+        assertEqual(MAX_PRESS_DURATION_MS, testMock.getLastEvent().pressDuration);
+    }
 }
 
-unittest_main()
\ No newline at end of file
+unittest_main()
@@ -0,0 +1,113 @@
+/**
+ *  @file       ListenerMock.h
+ *  Project     ObjectButton
+ *  @brief      An Arduino library for detecting button actions.
+ *  @author     JSC TechMinds
+ *  License     Apache-2.0 - Copyright (c) 2019-2024 JSC TechMinds
+ *
+ *  @section License
+ *
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "../src/ObjectButton.h"
+using namespace jsc;
+
+/**
+ * @brief Helper class used in unit tests.
+ *
+ * Purpose of this class is to serve as an IButtonEventListener and record events as they happen.
+ * In our unit tests we can check how many events of each type occurred and inspect the last event.
+ */
+class EventListenerMock : public IButtonEventListener {
+public:
+    /**
+     * @brief Get number of events of a type which occurred since this mock was reset.
+     * @param type event type.
+     * @return a number of events.
+     */
+    int getEventsReceivedCount(ButtonEventType type);
+
+    /**
+     * @brief Get number of all events which occurred since this mock was reset.
+     * @return a number of events.
+     */
+    int getAllEventsReceivedCount();
+
+    /**
+     * @brief Get the last received event.
+     * @return a reference to the last event.
+     */
+    const ButtonEvent& getLastEvent();
+
+    /**
+     * @brief Decide whether this mock observes double-click events.
+     * @param observed <code>true</code> to observe double-click events.
+     */
+    void setDoubleClickObserved(bool observed);
+
+    /**
+     * @brief Reset this mock listener to default state, including counters.
+     */
+    void resetState();
+
+    void onEvent(Button& button, const ButtonEvent& event) override;
+
+    bool observes(ButtonEventType type) override;
+
+private:
+    constexpr static int EVENT_TYPES = static_cast<int>(ButtonEventType::REPEAT) + 1;
+
+    int m_eventsReceived[EVENT_TYPES] = {};
+    ButtonEvent m_lastEvent = {};
+    bool m_doubleClickObserved = true;
+};
+
+int EventListenerMock::getEventsReceivedCount(ButtonEventType type) {
+    return m_eventsReceived[static_cast<int>(type)];
+}
+
+int EventListenerMock::getAllEventsReceivedCount() {
+    int count = 0;
+    for (int i = 0; i < EVENT_TYPES; i++)
+        count += m_eventsReceived[i];
+    return count;
+}
+
+const ButtonEvent& EventListenerMock::getLastEvent() {
+    return m_lastEvent;
+}
+
+void EventListenerMock::setDoubleClickObserved(bool observed) {
+    m_doubleClickObserved = observed;
+}
+
+void EventListenerMock::resetState() {
+    for (int i = 0; i < EVENT_TYPES; i++)
+        m_eventsReceived[i] = 0;
+    m_lastEvent = ButtonEvent();
+    m_doubleClickObserved = true;
+}
+
+void EventListenerMock::onEvent(Button& button, const ButtonEvent& event) {
+    m_eventsReceived[static_cast<int>(event.type)]++;
+    m_lastEvent = event;
+}
+
+bool EventListenerMock::observes(ButtonEventType type) {
+    return type != ButtonEventType::DOUBLE_CLICK || m_doubleClickObserved;
+}
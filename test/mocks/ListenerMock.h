@@ -62,6 +62,12 @@ public:
      */
     int getClickEventsReceivedCount();
 
+    /**
+     * @brief Get number of click cancelled events which occurred since this mock was reset.
+     * @return a number of click cancelled events.
+     */
+    int getClickCancelledEventsReceivedCount();
+
     /**
      * @brief Get number of double-click events which occurred since this mock was reset.
      * @return a number of double-click events.
@@ -93,13 +99,27 @@ public:
     int getLongPressEndEventsReceivedCount();
 
     /**
-     * @brief Reset this mock listener to default state, including counters.
+     * @brief Get number of repeat events which occurred since this mock was reset.
+     * @return a number of repeat events.
+     */
+    int getRepeatEventsReceivedCount();
+
+    /**
+     * @brief Get repeat count passed with the last repeat event.
+     * @return the repeat count, zero if no repeat event occurred.
+     */
+    uint8_t getLastRepeatCount();
+
+    /**
+     * @brief Reset this mock listener to default state, including counters and listeners set on the button.
      */
     void resetState();
 
 private:
     void onClick(Button& button) override;
 
+    void onClickCancelled(Button& button) override;
+
     void onDoubleClick(Button& button) override;
 
     void onPress(Button& button) override;
@@ -110,13 +130,18 @@ private:
 
     void onLongPressEnd(Button& button) override;
 
+    void onRepeat(Button& button, uint8_t count) override;
+
     Button& m_button;
     int m_onClickEventsReceived = 0;
+    int m_onClickCancelledEventsReceived = 0;
     int m_onDoubleClickEventsReceived = 0;
     int m_onPressEventsReceived = 0;
     int m_onReleaseEventsReceived = 0;
     int m_onLongPressStartEventsReceived = 0;
     int m_onLongPressEndEventsReceived = 0;
+    int m_onRepeatEventsReceived = 0;
+    uint8_t m_lastRepeatCount = 0;
 };
 
 ListenerMock::ListenerMock(Button& button) : m_button(button) {
@@ -133,6 +158,10 @@ int ListenerMock::getClickEventsReceivedCount() {
     return m_onClickEventsReceived;
 };
 
+int ListenerMock::getClickCancelledEventsReceivedCount() {
+    return m_onClickCancelledEventsReceived;
+};
+
 int ListenerMock::getDoubleClickEventsReceivedCount() {
     return m_onDoubleClickEventsReceived;
 };
@@ -153,20 +182,38 @@ int ListenerMock::getLongPressEndEventsReceivedCount() {
     return m_onLongPressEndEventsReceived;
 };
 
+int ListenerMock::getRepeatEventsReceivedCount() {
+    return m_onRepeatEventsReceived;
+};
+
+uint8_t ListenerMock::getLastRepeatCount() {
+    return m_lastRepeatCount;
+};
+
 void ListenerMock::resetState() {
     m_button.reset();
+    m_button.setOnClickListener(this);
+    m_button.setOnDoubleClickListener(this);
+    m_button.setOnPressListener(this);
     m_onClickEventsReceived = 0;
+    m_onClickCancelledEventsReceived = 0;
     m_onDoubleClickEventsReceived = 0;
     m_onPressEventsReceived = 0;
     m_onReleaseEventsReceived = 0;
     m_onLongPressStartEventsReceived = 0;
     m_onLongPressEndEventsReceived = 0;
+    m_onRepeatEventsReceived = 0;
+    m_lastRepeatCount = 0;
 }
 
 void ListenerMock::onClick(Button& button) {
     m_onClickEventsReceived++;
 }
 
+void ListenerMock::onClickCancelled(Button& button) {
+    m_onClickCancelledEventsReceived++;
+}
+
 void ListenerMock::onDoubleClick(Button& button) {
     m_onDoubleClickEventsReceived++;
 }
@@ -186,3 +233,8 @@ void ListenerMock::onLongPressStart(Button& button) {
 void ListenerMock::onLongPressEnd(Button& button) {
     m_onLongPressEndEventsReceived++;
 }
+
+void ListenerMock::onRepeat(Button& button, uint8_t count) {
+    m_onRepeatEventsReceived++;
+    m_lastRepeatCount = count;
+}
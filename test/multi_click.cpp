@@ -0,0 +1,176 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+
+constexpr static unsigned long CLICK_PERIOD_MS = 120;
+
+/*
+ * Click the button <code>count</code> times starting at <code>time</code>, ticking every millisecond.
+ * Each click is held for 60 ms and followed by a 60 ms pause.
+ * @return time after the last release.
+ */
+static unsigned long clicks(unsigned long time, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        for (unsigned long t = 0; t < CLICK_PERIOD_MS; t++)
+            digitalButton.tick(time + t, t < CLICK_PERIOD_MS / 2);
+        time += CLICK_PERIOD_MS;
+    }
+    return time;
+}
+
+/*
+ * Keep the button released, ticking every millisecond.
+ */
+static void wait(unsigned long from, unsigned long to) {
+    for (unsigned long t = from; t < to; t++)
+        digitalButton.tick(t, false);
+}
+
+unittest_setup() {
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    digitalButton.setCallbacks(nullptr);
+    testMock.resetState();
+}
+
+unittest(double_click_ends_sequence_by_default) {
+    clicks(1000, 2);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(2, testMock.getLastEvent().clickCount);
+
+    // third click starts a new sequence
+    unsigned long time = clicks(1000 + 2 * CLICK_PERIOD_MS, 1);
+    wait(time, time + DEFAULT_CLICK_TICKS_MS);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+}
+
+unittest(triple_click_is_reported_once_sequence_settles) {
+    digitalButton.setMaxClickCount(5);
+
+    unsigned long time = clicks(1000, 3);
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+    assertEqual(3, digitalButton.getClickCount());
+
+    wait(time, time + DEFAULT_CLICK_TICKS_MS);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+    assertEqual(3, testMock.getLastEvent().clickCount);
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertTrue(digitalButton.isIdle());
+}
+
+unittest(double_click_waits_for_third_click) {
+    digitalButton.setMaxClickCount(3);
+
+    unsigned long time = clicks(1000, 2);
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(DEFAULT_CLICK_TICKS_MS + 1 - CLICK_PERIOD_MS, digitalButton.nextDeadline(time));
+
+    wait(time, time + DEFAULT_CLICK_TICKS_MS);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::DOUBLE_CLICK));
+    assertEqual(2, testMock.getLastEvent().clickCount);
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+}
+
+unittest(single_click_is_a_click) {
+    digitalButton.setMaxClickCount(4);
+
+    unsigned long time = clicks(1000, 1);
+    wait(time, time + DEFAULT_CLICK_TICKS_MS);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(1, testMock.getLastEvent().clickCount);
+}
+
+unittest(reaching_max_count_reports_at_once) {
+    digitalButton.setMaxClickCount(4);
+
+    // release of the fourth click is 60 ms into its period
+    clicks(1000, 3);
+    for (unsigned long t = 0; t <= CLICK_PERIOD_MS / 2; t++)
+        digitalButton.tick(1000 + 3 * CLICK_PERIOD_MS + t, t < CLICK_PERIOD_MS / 2);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+    assertEqual(4, testMock.getLastEvent().clickCount);
+    assertEqual(1000 + 3 * CLICK_PERIOD_MS + CLICK_PERIOD_MS / 2, testMock.getLastEvent().time);
+    assertTrue(digitalButton.isIdle());
+}
+
+unittest(max_count_is_clamped) {
+    digitalButton.setMaxClickCount(200);
+    clicks(1000, MAX_CLICK_COUNT);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+    assertEqual(MAX_CLICK_COUNT, testMock.getLastEvent().clickCount);
+}
+
+int doubleClicks = 0;
+
+unittest(unobserved_multi_click_ends_sequence_with_double_click) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnDoubleClick([](Button &button, void *context) {
+        (*static_cast<int *>(context))++;
+    }, &doubleClicks);
+    digitalButton.setEventListener(nullptr);
+    digitalButton.setCallbacks(&callbacks);
+    digitalButton.setMaxClickCount(5);
+
+    clicks(1000, 2);
+    assertEqual(1, doubleClicks);
+    assertTrue(digitalButton.isIdle());
+}
+
+unittest(speculative_click_is_cancelled_by_multi_click) {
+    digitalButton.setMaxClickCount(3);
+    digitalButton.setSpeculativeClick(true);
+
+    clicks(1000, 1);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+
+    clicks(1000 + CLICK_PERIOD_MS, 2);
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK_CANCELLED));
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::MULTI_CLICK));
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+}
+
+int multiClickCount = 0;
+
+unittest(callback_reads_click_count) {
+    ButtonCallbacks callbacks;
+    callbacks.setOnMultiClick([](Button &button, void *context) {
+        *static_cast<int *>(context) = button.getClickCount();
+    }, &multiClickCount);
+    digitalButton.setCallbacks(&callbacks);
+    digitalButton.setMaxClickCount(6);
+
+    unsigned long time = clicks(1000, 5);
+    wait(time, time + DEFAULT_CLICK_TICKS_MS);
+
+    assertEqual(5, multiClickCount);
+}
+
+unittest_main()
@@ -0,0 +1,110 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+ListenerMock testMock = ListenerMock(digitalButton);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    testMock.resetState();
+    state->reset();
+}
+
+unittest(idle_button_has_no_deadline) {
+    state->digitalPin[INPUT_PIN] = HIGH;
+    testMock.getButton().tick();
+
+    assertEqual(NO_DEADLINE, testMock.getButton().nextDeadline());
+}
+
+unittest(pressed_button_waits_for_debounce_then_long_press) {
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 1, testMock.getButton().nextDeadline());
+
+    // sleeping until the deadline is enough to get press event
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    assertEqual(0, testMock.getButton().nextDeadline());
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(DEFAULT_LONG_PRESS_TICKS_MS - DEFAULT_DEBOUNCE_TICKS_MS, testMock.getButton().nextDeadline());
+
+    // sleeping until the deadline is enough to get long press event
+    state->micros = (DEFAULT_LONG_PRESS_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getLongPressStartEventsReceivedCount());
+
+    // press duration is measured until it saturates
+    assertEqual(MAX_PRESS_DURATION_MS - DEFAULT_LONG_PRESS_TICKS_MS - 1, testMock.getButton().nextDeadline());
+    state->micros = MAX_PRESS_DURATION_MS * 1000UL;
+    testMock.getButton().tick();
+
+    // only release can change state now
+    assertEqual(NO_DEADLINE, testMock.getButton().nextDeadline());
+}
+
+unittest(released_button_waits_for_click_timeout) {
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    testMock.getButton().tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+
+    // release button
+    state->micros = 100 * 1000;
+    state->digitalPin[INPUT_PIN] = HIGH;
+    testMock.getButton().tick();
+
+    // release debounce elapses first
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 1, testMock.getButton().nextDeadline());
+
+    // click timeout follows
+    state->micros = (100 + DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    assertEqual(DEFAULT_CLICK_TICKS_MS + 1 - (100 + DEFAULT_DEBOUNCE_TICKS_MS + 1),
+                testMock.getButton().nextDeadline());
+
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    testMock.getButton().tick();
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(NO_DEADLINE, testMock.getButton().nextDeadline());
+}
+
+unittest(group_reports_earliest_deadline) {
+    DigitalButton otherButton = DigitalButton(INPUT_PIN + 1, true);
+    ButtonGroup<2> group;
+    group.add(digitalButton);
+    group.add(otherButton);
+
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->digitalPin[INPUT_PIN + 1] = HIGH;
+    group.tick();
+    assertEqual(NO_DEADLINE, group.nextDeadline());
+
+    state->digitalPin[INPUT_PIN + 1] = LOW;
+    group.tick();
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS + 1, group.nextDeadline());
+}
+
+unittest_main()
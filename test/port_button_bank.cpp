@@ -0,0 +1,124 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+DigitalButton button0 = DigitalButton(2, true);
+DigitalButton button3 = DigitalButton(5, true);
+ListenerMock testMock0 = ListenerMock(button0);
+ListenerMock testMock3 = ListenerMock(button3);
+GodmodeState* state = GODMODE();
+
+/* Mocked input register, all buttons are released (pulled up) */
+volatile uint8_t port = 0xFF;
+
+unittest_setup() {
+    testMock0.resetState();
+    testMock3.resetState();
+    state->reset();
+    port = 0xFF;
+}
+
+unittest(attach_rejects_bit_out_of_range) {
+    PortButtonBank<uint8_t> bank = PortButtonBank<uint8_t>(&port);
+
+    assertEqual(true, bank.attach(7, button0));
+    assertEqual(false, bank.attach(8, button0));
+}
+
+unittest(input_is_debounced_after_four_consistent_samples) {
+    PortButtonBank<uint8_t> bank = PortButtonBank<uint8_t>(&port);
+
+    // press button on bit 0
+    port = 0xFE;
+    bank.tick(1);
+    bank.tick(2);
+    bank.tick(3);
+    assertEqual(0, bank.getState());
+
+    bank.tick(4);
+    assertEqual(1, bank.getState());
+}
+
+unittest(bouncing_input_does_not_press_button) {
+    PortButtonBank<uint8_t> bank = PortButtonBank<uint8_t>(&port);
+    bank.attach(0, button0);
+
+    for (unsigned long now = 0; now < 100; now++) {
+        port = (now % 3 == 0) ? 0xFF : 0xFE;
+        bank.tick(now);
+    }
+
+    assertEqual(0, bank.getState());
+    assertEqual(0, testMock0.getPressEventsReceivedCount());
+}
+
+unittest(only_pressed_bit_fires_events) {
+    PortButtonBank<uint8_t> bank = PortButtonBank<uint8_t>(&port);
+    bank.attach(0, button0);
+    bank.attach(3, button3);
+
+    // press button on bit 3
+    port = 0xF7;
+    for (unsigned long now = 0; now < 10; now++)
+        bank.tick(now);
+
+    // release it
+    port = 0xFF;
+    for (unsigned long now = 10; now < 20; now++)
+        bank.tick(now);
+
+    // wait for click timeout
+    bank.tick(DEFAULT_CLICK_TICKS_MS + 10);
+
+    assertEqual(0, testMock0.getPressEventsReceivedCount());
+    assertEqual(1, testMock3.getPressEventsReceivedCount());
+    assertEqual(1, testMock3.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock3.getClickEventsReceivedCount());
+}
+
+unittest(sample_provided_by_caller_with_active_high_inputs) {
+    PortButtonBank<uint16_t> bank = PortButtonBank<uint16_t>(nullptr, 0);
+    bank.attach(9, button0);
+
+    for (unsigned long now = 0; now < 10; now++)
+        bank.tick(now, 0x0200);
+
+    assertEqual(0x0200, bank.getState());
+    assertEqual(1, testMock0.getPressEventsReceivedCount());
+}
+
+unittest(attach_keeps_timing_of_button) {
+    PortButtonBank<uint8_t> bank = PortButtonBank<uint8_t>(&port);
+    bank.attach(0, button0);
+    assertEqual(DEFAULT_DEBOUNCE_TICKS_MS, button0.getTiming().debounceTicks);
+
+    // timing set after attach does not bring time-window debounce back
+    ButtonTiming slowTiming = {200, DEFAULT_CLICK_TICKS_MS, DEFAULT_LONG_PRESS_TICKS_MS};
+    button0.setTiming(slowTiming);
+
+    port = 0xFE;
+    for (unsigned long now = 1000; now < 1006; now++)
+        bank.tick(now);
+
+    assertEqual(1, testMock0.getPressEventsReceivedCount());
+    assertEqual(200, button0.getTiming().debounceTicks);
+}
+
+unittest_main()
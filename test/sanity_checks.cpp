@@ -37,6 +37,11 @@ unittest(button_not_pressed) {
     assertEqual(false, analogButton.isLongPressed());
 }
 
+unittest(button_idle_by_default) {
+    assertEqual(true, digitalButton.isIdle());
+    assertEqual(true, analogButton.isIdle());
+}
+
 unittest(button_not_pressed_after_reset) {
     digitalButton.reset();
     assertEqual(false, digitalButton.isLongPressed());
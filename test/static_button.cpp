@@ -0,0 +1,110 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/ListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+constexpr static byte CUSTOM_INPUT_PIN = 11;
+constexpr static uint16_t CUSTOM_DEBOUNCE_TICKS_MS = 10;
+constexpr static uint16_t CUSTOM_CLICK_TICKS_MS = 100;
+constexpr static uint16_t CUSTOM_LONG_PRESS_TICKS_MS = 300;
+
+StaticButton<INPUT_PIN> staticButton;
+StaticButton<CUSTOM_INPUT_PIN, false, CUSTOM_DEBOUNCE_TICKS_MS, CUSTOM_CLICK_TICKS_MS, CUSTOM_LONG_PRESS_TICKS_MS> customButton;
+ListenerMock testMock = ListenerMock(staticButton);
+ListenerMock customMock = ListenerMock(customButton);
+GodmodeState* state = GODMODE();
+
+unittest_setup() {
+    testMock.resetState();
+    customMock.resetState();
+    state->reset();
+}
+
+unittest(button_id_matches_input_pin) {
+    assertEqual(INPUT_PIN, staticButton.getId());
+    assertEqual(CUSTOM_INPUT_PIN, customButton.getId());
+}
+
+unittest(receive_click_like_digital_button) {
+    // press button
+    state->digitalPin[INPUT_PIN] = LOW;
+    staticButton.tick();
+
+    // fire press event after debounce period elapses
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    staticButton.tick();
+
+    // release button
+    state->digitalPin[INPUT_PIN] = HIGH;
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 10) * 1000;
+    staticButton.tick();
+
+    // wait for click timeout
+    state->micros = (DEFAULT_CLICK_TICKS_MS + 1) * 1000;
+    staticButton.tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+    assertEqual(1, testMock.getReleaseEventsReceivedCount());
+    assertEqual(1, testMock.getClickEventsReceivedCount());
+    assertEqual(0, testMock.getDoubleClickEventsReceivedCount());
+}
+
+unittest(custom_timing_survives_reset) {
+    // active high input
+    state->digitalPin[CUSTOM_INPUT_PIN] = HIGH;
+    customButton.tick();
+
+    // custom debounce elapses
+    state->micros = (CUSTOM_DEBOUNCE_TICKS_MS + 1) * 1000;
+    customButton.tick();
+    assertEqual(1, customMock.getPressEventsReceivedCount());
+
+    // custom long press elapses
+    state->micros = (CUSTOM_LONG_PRESS_TICKS_MS + 1) * 1000;
+    customButton.tick();
+    assertEqual(1, customMock.getLongPressStartEventsReceivedCount());
+}
+
+unittest(deadline_follows_template_timing) {
+    state->digitalPin[CUSTOM_INPUT_PIN] = HIGH;
+    customButton.tick();
+    assertEqual(CUSTOM_DEBOUNCE_TICKS_MS + 1, customButton.nextDeadline());
+
+    // same deadline through the base class, which reads the timing profile
+    Button &button = customButton;
+    assertEqual(CUSTOM_DEBOUNCE_TICKS_MS + 1, button.nextDeadline());
+
+    state->micros = (CUSTOM_DEBOUNCE_TICKS_MS + 1) * 1000;
+    customButton.tick();
+    assertEqual(CUSTOM_LONG_PRESS_TICKS_MS - CUSTOM_DEBOUNCE_TICKS_MS, customButton.nextDeadline());
+}
+
+unittest(ticking_through_base_class_reads_the_same_input) {
+    Button &button = staticButton;
+
+    state->digitalPin[INPUT_PIN] = LOW;
+    button.tick();
+    state->micros = (DEFAULT_DEBOUNCE_TICKS_MS + 1) * 1000;
+    button.tick();
+
+    assertEqual(1, testMock.getPressEventsReceivedCount());
+}
+
+unittest_main()
@@ -0,0 +1,153 @@
+/**
+ *  Copyright (c) 2019-2024 JSC TechMinds
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ArduinoUnitTests.h>
+#include "../src/ObjectButton.h"
+#include "mocks/EventListenerMock.h"
+using namespace jsc;
+
+constexpr static byte INPUT_PIN = 10;
+
+DigitalButton digitalButton = DigitalButton(INPUT_PIN, true);
+EventListenerMock testMock;
+GodmodeState* state = GODMODE();
+
+TickMonitor monitor;
+unsigned long budgetGap = 0;
+int budgetExceeded = 0;
+
+static void onBudgetExceeded(unsigned long gap, void *context) {
+    budgetGap = gap;
+    (*static_cast<int *>(context))++;
+}
+
+static void tickAt(ButtonGroup<1> &group, unsigned long now, bool pressed) {
+    state->micros = now * 1000;
+    state->digitalPin[INPUT_PIN] = pressed ? LOW : HIGH;
+    group.tick();
+}
+
+unittest_setup() {
+    digitalButton.reset();
+    digitalButton.setEventListener(&testMock);
+    testMock.resetState();
+    testMock.setDoubleClickObserved(false);
+    monitor.reset();
+    monitor.setBudget(0, nullptr);
+    budgetGap = 0;
+    budgetExceeded = 0;
+    state->reset();
+}
+
+unittest(largest_tick_gap_is_tracked) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    tickAt(group, 1000, false);
+    assertEqual(0, monitor.getMaxTickGap());
+
+    tickAt(group, 1010, false);
+    tickAt(group, 1110, false);
+    tickAt(group, 1120, false);
+    assertEqual(100, monitor.getMaxTickGap());
+}
+
+unittest(idle_buttons_have_no_late_ticks) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    tickAt(group, 1000, false);
+    tickAt(group, 5000, false);
+    assertEqual(0, monitor.getLateTickCount());
+}
+
+unittest(ticks_after_deadline_are_late) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    // press event is due debounce interval after the press
+    tickAt(group, 1000, true);
+    tickAt(group, 1000 + DEFAULT_DEBOUNCE_TICKS_MS + 1, true);
+    assertEqual(0, monitor.getLateTickCount());
+
+    // long press start is due, tick comes 100 ms too late
+    tickAt(group, 1000 + DEFAULT_LONG_PRESS_TICKS_MS + 101, true);
+    assertEqual(1, monitor.getLateTickCount());
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::LONG_PRESS_START));
+}
+
+unittest(press_seen_by_single_slow_tick_is_counted) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    tickAt(group, 1000, false);
+    tickAt(group, 1100, true);
+    tickAt(group, 1200, false);
+
+    assertEqual(1, monitor.getShortPressCount());
+    assertEqual(0, testMock.getEventsReceivedCount(ButtonEventType::PRESS));
+}
+
+unittest(bounce_seen_by_single_fast_tick_is_not_counted) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+
+    tickAt(group, 1000, false);
+    tickAt(group, 1001, true);
+    tickAt(group, 1002, false);
+    tickAt(group, 1003, true);
+
+    // press held over many ticks is not short either
+    for (unsigned long now = 1004; now < 1200; now += 10)
+        tickAt(group, now, true);
+    tickAt(group, 1200, false);
+
+    assertEqual(0, monitor.getShortPressCount());
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+}
+
+unittest(callback_fires_when_budget_is_exceeded) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+    group.setTickMonitor(&monitor);
+    monitor.setBudget(20, onBudgetExceeded, &budgetExceeded);
+
+    tickAt(group, 1000, false);
+    tickAt(group, 1020, false);
+    assertEqual(0, budgetExceeded);
+
+    tickAt(group, 1045, false);
+    assertEqual(1, budgetExceeded);
+    assertEqual(25, budgetGap);
+}
+
+unittest(group_without_monitor_ticks_buttons) {
+    ButtonGroup<1> group;
+    group.add(digitalButton);
+
+    tickAt(group, 1000, true);
+    tickAt(group, 1100, false);
+
+    assertEqual(1, testMock.getEventsReceivedCount(ButtonEventType::CLICK));
+    assertEqual(0, monitor.getMaxTickGap());
+}
+
+unittest_main()